@@ -107,6 +107,7 @@ public:
         const VibratorPackage &beforeModulationPackage, VibratorPackage &afterModulationPackage);
     int32_t DisableVibratorByPid(int32_t pid);
     int32_t EnableVibratorByPid(int32_t pid);
+    int32_t PlayVibratorBatch(const VibrateBatchIPC &batch);
 
 private:
     int32_t InitServiceClient();
@@ -255,6 +255,11 @@ int32_t VibratorServiceClient::StopVibrator(const VibratorIdentifier &identifier
 {
     MISC_HILOGD("StopVibrator begin, deviceId:%{public}d, vibratorId:%{public}d, mode:%{public}s", identifier.deviceId,
         identifier.vibratorId, mode.c_str());
+    VibrateMode vibrateMode = VIBRATE_BUTT;
+    if (!GetVibrateMode(mode, vibrateMode) || (vibrateMode == VIBRATE_BUTT)) {
+        MISC_HILOGE("Invalid mode:%{public}s", mode.c_str());
+        return PARAMETER_ERROR;
+    }
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) { // LCOV_EXCL_START
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
@@ -268,7 +273,7 @@ int32_t VibratorServiceClient::StopVibrator(const VibratorIdentifier &identifier
     VibratorIdentifierIPC vibrateIdentifier;
     vibrateIdentifier.deviceId = identifier.deviceId;
     vibrateIdentifier.vibratorId = identifier.vibratorId;
-    ret = miscdeviceProxy_->StopVibratorByMode(vibrateIdentifier, mode);
+    ret = miscdeviceProxy_->StopVibratorByMode(vibrateIdentifier, vibrateMode);
     WriteVibratorHiSysIPCEvent(IMiscdeviceServiceIpcCode::COMMAND_STOP_VIBRATOR_BY_MODE, ret);
 #ifdef HIVIEWDFX_HITRACE_ENABLE
     FinishTrace(HITRACE_TAG_SENSORS);
@@ -1476,6 +1481,10 @@ void VibratorServiceClient::WriteVibratorHiSysIPCEvent(IMiscdeviceServiceIpcCode
                 HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
                     HiSysEvent::EventType::FAULT, "PKG_NAME", "StopVibrateBySessionId", "ERROR_CODE", ret);
                 break;
+            case IMiscdeviceServiceIpcCode::COMMAND_PLAY_VIBRATOR_BATCH:
+                HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
+                    HiSysEvent::EventType::FAULT, "PKG_NAME", "PlayVibratorBatch", "ERROR_CODE", ret);
+                break;
             default: // LCOV_EXCL_START
                 MISC_HILOGW("Code does not exist, code:%{public}d", static_cast<int32_t>(code));
                 break; // LCOV_EXCL_STOP
@@ -1566,5 +1575,30 @@ int32_t VibratorServiceClient::EnableVibratorByPid(int32_t pid)
     MISC_HILOGD("Enable Vibrator for pid:%{public}d success", pid);
     return OHOS::Sensors::SUCCESS;
 } // LCOV_EXCL_STOP
+
+int32_t VibratorServiceClient::PlayVibratorBatch(const VibrateBatchIPC &batch)
+{
+    MISC_HILOGD("PlayVibratorBatch begin, items:%{public}zu, usage:%{public}d", batch.items.size(), batch.usage);
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) { // LCOV_EXCL_START
+        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return MISC_NATIVE_GET_SERVICE_ERR;
+    } // LCOV_EXCL_STOP
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    CHKPR(miscdeviceProxy_, ERROR);
+#ifdef HIVIEWDFX_HITRACE_ENABLE
+    StartTrace(HITRACE_TAG_SENSORS, "PlayVibratorBatch");
+#endif // HIVIEWDFX_HITRACE_ENABLE
+    ret = miscdeviceProxy_->PlayVibratorBatch(batch);
+    WriteVibratorHiSysIPCEvent(IMiscdeviceServiceIpcCode::COMMAND_PLAY_VIBRATOR_BATCH, ret);
+#ifdef HIVIEWDFX_HITRACE_ENABLE
+    FinishTrace(HITRACE_TAG_SENSORS);
+#endif // HIVIEWDFX_HITRACE_ENABLE
+    if (ret != ERR_OK) {
+        MISC_HILOGE("PlayVibratorBatch failed, ret:%{public}d, items:%{public}zu, usage:%{public}d",
+            ret, batch.items.size(), batch.usage);
+    }
+    return ret;
+}
 } // namespace Sensors
 } // namespace OHOS
@@ -58,6 +58,8 @@ public:
         std::vector<HdfVibratorInfo> &vibratorInfoIpc) override;
     int32_t GetEffectInfo(const VibratorIdentifierIPC &identifier, const std::string &effectType,
         HdfEffectInfo &effectInfo) override;
+    int32_t PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet) override;
+    int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) override;
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     int32_t RegisterVibratorPlugCallback(DevicePlugCallback cb) override;
     DevicePlugCallback GetVibratorPlugCb() override;
@@ -71,4 +73,4 @@ private:
 };
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // DIRECT_CONNECTION_H
\ No newline at end of file
+#endif  // DIRECT_CONNECTION_H
\ No newline at end of file
@@ -67,6 +67,8 @@ public:
         std::vector<HdfVibratorInfo> &vibratorInfoIpc) override;
     int32_t GetEffectInfo(const VibratorIdentifierIPC &identifier, const std::string &effectType,
         HdfEffectInfo &effectInfo) override;
+    int32_t PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet) override;
+    int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) override;
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     int32_t RegisterVibratorPlugCallback(DevicePlugCallback cb) override;
     DevicePlugCallback GetVibratorPlugCb() override;
@@ -85,4 +87,4 @@ private:
 };
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // HDI_CONNECTION_H
\ No newline at end of file
+#endif  // HDI_CONNECTION_H
\ No newline at end of file
@@ -178,6 +178,21 @@ int32_t CompatibleConnection::PlayPattern(const VibratorIdentifierIPC &identifie
     return ERR_OK;
 }
 
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+int32_t CompatibleConnection::PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet)
+{
+    packet = {};
+    packet.time = pattern.startTime;
+    packet.eventNum = static_cast<int32_t>(pattern.events.size());
+    return ERR_OK;
+}
+
+int32_t CompatibleConnection::PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet)
+{
+    return ERR_OK;
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
 int32_t CompatibleConnection::PlayPatternBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId,
     const VibratePattern &pattern)
 {
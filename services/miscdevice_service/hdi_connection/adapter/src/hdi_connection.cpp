@@ -264,6 +264,19 @@ int32_t HdiConnection::PlayPattern(const VibratorIdentifierIPC &identifier, cons
     CHKPR(vibratorInterface_, ERR_INVALID_VALUE);
     HapticPaket packet = {};
     GetHapticPaket(pattern, packet);
+    return PlayHapticPaket(identifier, packet);
+}
+
+int32_t HdiConnection::PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet)
+{
+    packet = {};
+    GetHapticPaket(pattern, packet);
+    return ERR_OK;
+}
+
+int32_t HdiConnection::PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet)
+{
+    CHKPR(vibratorInterface_, ERR_INVALID_VALUE);
     DeviceVibratorInfo deviceVibratorInfo = {
         .deviceId = identifier.deviceId,
         .vibratorId = identifier.vibratorId
@@ -83,6 +83,8 @@ public:
         std::vector<HdfVibratorInfo> &hdfVibratorInfo) = 0;
     virtual int32_t GetEffectInfo(const VibratorIdentifierIPC &identifier, const std::string &effectType,
         HdfEffectInfo &effectInfo) = 0;
+    virtual int32_t PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet) = 0;
+    virtual int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) = 0;
     virtual int32_t PlayPackageBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId,
         const VibratePackage &package) = 0;
     virtual int32_t StopVibrateBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId) = 0;
@@ -95,4 +97,4 @@ private:
 };
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // I_VIBRATOR_HDI_CONNECTION_H
\ No newline at end of file
+#endif  // I_VIBRATOR_HDI_CONNECTION_H
\ No newline at end of file
@@ -53,6 +53,8 @@ public:
         std::vector<HdfVibratorInfo> &hdfVibratorInfo) override;
     int32_t GetEffectInfo(const VibratorIdentifierIPC &identifier, const std::string &effectType,
         HdfEffectInfo &effectInfo) override;
+    int32_t PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet) override;
+    int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) override;
     int32_t PlayPatternBySessionId(const VibratorIdentifierIPC &identifier,
         uint32_t sessionId, const VibratePattern &pattern) override;
     int32_t PlayPackageBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId,
@@ -68,4 +70,4 @@ private:
 };
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // VIBRATOR_HDI_CONNECTION_H
\ No newline at end of file
+#endif  // VIBRATOR_HDI_CONNECTION_H
\ No newline at end of file
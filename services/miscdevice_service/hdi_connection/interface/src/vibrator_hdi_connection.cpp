@@ -164,6 +164,27 @@ int32_t VibratorHdiConnection::PlayPattern(const VibratorIdentifierIPC &identifi
     return iVibratorHdiConnection_->PlayPattern(identifier, pattern);
 }
 
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+int32_t VibratorHdiConnection::PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet)
+{
+    CHKPR(iVibratorHdiConnection_, VIBRATOR_HDF_CONNECT_ERR);
+    return iVibratorHdiConnection_->PrepareHapticPaket(pattern, packet);
+}
+
+int32_t VibratorHdiConnection::PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet)
+{
+    CHKPR(iVibratorHdiConnection_, VIBRATOR_HDF_CONNECT_ERR);
+#ifdef HIVIEWDFX_HITRACE_ENABLE
+    StartTrace(HITRACE_TAG_SENSORS, "PlayHapticPaket");
+#endif // HIVIEWDFX_HITRACE_ENABLE
+    int32_t ret = iVibratorHdiConnection_->PlayHapticPaket(identifier, packet);
+#ifdef HIVIEWDFX_HITRACE_ENABLE
+    FinishTrace(HITRACE_TAG_SENSORS);
+#endif // HIVIEWDFX_HITRACE_ENABLE
+    return ret;
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
 int32_t VibratorHdiConnection::PlayPatternBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId,
     const VibratePattern &pattern)
 {
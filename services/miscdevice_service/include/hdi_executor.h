@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HDI_EXECUTOR_H
+#define HDI_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "singleton.h"
+
+namespace OHOS {
+namespace Sensors {
+enum HdiDomain {
+    HDI_DOMAIN_VIBRATOR = 0,
+    HDI_DOMAIN_LIGHT,
+};
+
+struct HdiExecutorStats {
+    HdiDomain domain = HDI_DOMAIN_VIBRATOR;
+    int32_t deviceId = -1;
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    uint64_t executed = 0;
+    uint64_t rejected = 0;
+};
+
+/**
+ * One worker per hardware device that runs HDI calls in submission order, so binder threads only
+ * enqueue and a slow driver stalls its own queue instead of the IPC thread pool.
+ */
+class HdiExecutor : public Singleton<HdiExecutor> {
+public:
+    HdiExecutor() = default;
+    virtual ~HdiExecutor();
+    /** Starts the queue of a known device, posts to devices never added or already removed are rejected */
+    void Add(HdiDomain domain, int32_t deviceId);
+    /** Returns false when the device is unknown or its queue is full, urgent tasks such as stops skip the capacity */
+    bool Post(HdiDomain domain, int32_t deviceId, std::function<void()> task, bool urgent = false);
+    /** Runs the task behind everything already queued for the device, it is cancelled if still queued at the timeout */
+    bool PostAndWait(HdiDomain domain, int32_t deviceId, std::function<void()> task);
+    void Remove(HdiDomain domain, int32_t deviceId);
+    void Shutdown();
+    std::vector<HdiExecutorStats> GetStats();
+
+private:
+    struct Lane {
+        std::mutex laneMutex;
+        std::condition_variable laneCv;
+        std::deque<std::function<void()>> tasks;
+        std::thread worker;
+        bool quit = false;
+        size_t maxDepth = 0;
+        uint64_t executed = 0;
+        uint64_t rejected = 0;
+    };
+    enum TaskState {
+        TASK_PENDING = 0,
+        TASK_RUNNING,
+        TASK_CANCELLED,
+    };
+    using LaneKey = std::pair<HdiDomain, int32_t>;
+    std::shared_ptr<Lane> GetLane(HdiDomain domain, int32_t deviceId);
+    static void RunLane(std::shared_ptr<Lane> lane);
+    static void StopLane(const std::shared_ptr<Lane> &lane);
+    std::mutex lanesMutex_;
+    std::map<LaneKey, std::shared_ptr<Lane>> lanes_;
+};
+#define HdiExecutorPool HdiExecutor::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // HDI_EXECUTOR_H
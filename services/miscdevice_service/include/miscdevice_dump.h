@@ -16,6 +16,8 @@
 #ifndef MISCDEVICE_DUMP_H
 #define MISCDEVICE_DUMP_H
 
+#include <array>
+#include <atomic>
 #include <queue>
 
 #include "singleton.h"
@@ -24,9 +26,19 @@
 
 namespace OHOS {
 namespace Sensors {
+enum WakeupSource {
+    WAKEUP_COMMAND = 0,
+    WAKEUP_TIMER,
+    WAKEUP_SOURCE_MAX,
+};
+
+/** Log2 buckets in microseconds, the last one collects everything slower */
+constexpr size_t WAKEUP_LATENCY_BUCKETS = 20;
+
+/** Stamped with a raw CLOCK_REALTIME value, only formatted when the records are dumped */
 struct VibrateRecord {
-    std::string startTime;
-    VibrateInfo info;
+    int64_t startTimeMs = 0;
+    VibrateInfoPtr info;
 };
 
 class MiscdeviceDump {
@@ -36,12 +48,22 @@ public:
     void DumpHelp(int32_t fd);
     void DumpMiscdeviceRecord(int32_t fd);
     void ParseCommand(int32_t fd, const std::vector<std::string> &args);
-    void SaveVibrateRecord(const VibrateInfo &vibrateInfo);
+    void SaveVibrateRecord(const VibrateInfoPtr &vibrateInfo);
+    void DumpWakeupLatency(int32_t fd);
+    void SaveWakeupLatency(WakeupSource source, int64_t latencyUs);
+    void DumpPermissionVerdicts(int32_t fd);
+    void DumpEffectCatalog(int32_t fd);
+    void DumpRateLimiter(int32_t fd);
+    void DumpCoalescer(int32_t fd);
+    void DumpHdiExecutor(int32_t fd);
+    void DumpPlugEvent(int32_t fd);
 
 private:
     std::queue<VibrateRecord> dumpQueue_;
     std::mutex recordQueueMutex_;
-    void DumpCurrentTime(std::string &startTime);
+    std::array<std::array<std::atomic_uint64_t, WAKEUP_LATENCY_BUCKETS>, WAKEUP_SOURCE_MAX> wakeupLatency_ {};
+    std::array<std::atomic_int64_t, WAKEUP_SOURCE_MAX> maxWakeupLatencyUs_ {};
+    std::string FormatTime(int64_t timeMs);
     void UpdateRecordQueue(const VibrateRecord &record);
     std::string GetUsageName(int32_t usage);
     void RunVibratorDump(int32_t fd, int32_t optionIndex, const std::vector<std::string> &args, char **argv);
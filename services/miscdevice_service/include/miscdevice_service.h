@@ -16,6 +16,10 @@
 #ifndef MISCDEVICE_SERVICE_H
 #define MISCDEVICE_SERVICE_H
 
+#include <future>
+#include <shared_mutex>
+#include <unordered_set>
+
 #include "accesstoken_kit.h"
 #include "common_event_manager.h"
 #include "system_ability.h"
@@ -26,6 +30,13 @@
 #include "miscdevice_delayed_sp_singleton.h"
 #include "miscdevice_dump.h"
 #include "miscdevice_service_stub.h"
+#include "hdi_executor.h"
+#include "package_name_cache.h"
+#include "plug_event_dispatcher.h"
+#include "vibrate_coalescer.h"
+#include "vibrate_rate_limiter.h"
+#include "vibration_owner_index.h"
+#include "vibrator_effect_catalog.h"
 #include "vibrator_thread.h"
 
 namespace OHOS {
@@ -64,10 +75,35 @@ struct VibratorAllInfos {
     std::vector<VibratorInfoIPC> baseInfo;
     VibratorControlInfo controlInfo;
     VibratorCapacity capacityInfo;
-    std::vector<HdfWaveInformation> waveInfo;
+    WaveInfosPtr waveInfo = std::make_shared<const std::vector<HdfWaveInformation>>();
+    /** HDI start-up delay per vibrate mode, static for the actuator so it is queried only at insertion */
+    std::map<int32_t, int32_t> startUpTimes;
+    /** Serializes start and stop on this device only, other devices are never blocked by its HDI calls */
+    std::shared_ptr<std::mutex> playbackMutex = std::make_shared<std::mutex>();
     VibratorAllInfos(const std::vector<int>& vibratorIds) : controlInfo(vibratorIds) {}
 };
 
+/** One motor resolved from the device table, stays usable after the table lock is released */
+struct VibratorTarget {
+    VibratorIdentifierIPC identifier;
+    std::shared_ptr<VibratorThread> thread;
+    WaveInfosPtr waveInfo;
+    std::shared_ptr<std::mutex> playbackMutex;
+};
+
+/** Background capacity and wave query of a newly plugged device, requests to that device wait on it */
+struct VibratorProbe {
+    std::shared_ptr<std::promise<void>> promise;
+    std::shared_future<void> done;
+};
+
+struct RemoteObjectHash {
+    size_t operator()(const sptr<IRemoteObject> &remote) const
+    {
+        return std::hash<IRemoteObject *>()(remote.GetRefPtr());
+    }
+};
+
 struct InvalidVibratorInfo {
     int32_t maxInvalidVibratorId;
     int32_t invalidCallTimes;
@@ -95,7 +131,7 @@ public:
         const CustomHapticInfoIPC& customHapticInfoIPC) override;
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
     virtual int32_t StopVibrator(const VibratorIdentifierIPC& identifier) override;
-    virtual int32_t StopVibratorByMode(const VibratorIdentifierIPC& identifier, const std::string &mode) override;
+    virtual int32_t StopVibratorByMode(const VibratorIdentifierIPC& identifier, int32_t mode) override;
     virtual int32_t IsSupportEffect(const VibratorIdentifierIPC& identifier, const std::string &effect,
         bool &state) override;
     virtual int32_t GetLightList(std::vector<LightInfoIPC> &lightInfoIpcList) override;
@@ -119,23 +155,46 @@ public:
     virtual int32_t SubscribeVibratorPlugInfo(const sptr<IRemoteObject> &vibratorServiceClient) override;
     virtual int32_t DisableVibratorByPid(int32_t pid) override;
     virtual int32_t EnableVibratorByPid(int32_t pid) override;
+    virtual int32_t PlayVibratorBatch(const VibrateBatchIPC &batch) override;
 
 private:
     DISALLOW_COPY_AND_MOVE(MiscdeviceService);
     bool InitInterface();
     bool InitLightInterface();
     std::string GetPackageName(AccessTokenID tokenId);
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    std::optional<HdfEffectInfo> GetCachedEffectInfo(const VibratorIdentifierIPC& identifier,
+        const std::string &effect);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+    std::string QueryPackageName(AccessTokenID tokenId);
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
     int32_t FastVibratorEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier);
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
-    void StartVibrateThread(VibrateInfo info, const VibratorIdentifierIPC& identifier);
+    void StartVibrateThread(const VibrateInfoPtr &info, const VibratorTarget &target,
+        const std::shared_ptr<PlaybackGroup> &group = nullptr);
+    void StartVibrateGroup(const VibrateInfoPtr &info, const std::vector<VibratorTarget> &targets);
+    std::shared_ptr<PlaybackGroup> CreatePlaybackGroup(const std::vector<VibratorTarget> &targets);
+    int32_t BuildBatchVibrateInfo(const VibrateBatchItemIPC &item, VibrateInfo &info);
+    int32_t StartVibrateBatch(const VibrateBatchIPC &batch, const std::vector<VibrateInfoPtr> &infos);
     int32_t StopVibratorService(const VibratorIdentifierIPC& identifier);
+    size_t StopVibratorTargets(const std::vector<VibratorTarget> &targets);
+    std::vector<VibratorTarget> ResolveVibratorTargets(const VibratorIdentifierIPC& identifier);
+    static std::vector<std::unique_lock<std::mutex>> LockPlayback(const std::vector<VibratorTarget> &targets);
     void SendMsgToClient(const HdfVibratorPlugInfo &info);
     int32_t RegisterVibratorPlugCb();
-    std::shared_ptr<VibratorThread> GetVibratorThread(const VibratorIdentifierIPC& identifier);
     void StopVibrateThread(std::shared_ptr<VibratorThread> vibratorThread);
-    bool ShouldIgnoreVibrate(const VibrateInfo &info, const VibratorIdentifierIPC& identifier);
-    std::string GetCurrentTime();
+    void StopPreviousPlayback(const VibratorTarget &target);
+    bool ShouldIgnoreVibrate(const VibrateInfo &info, const VibratorTarget &target);
+    bool IsVibrateAdmitted(int32_t usage);
+    void LoadRateConfigs();
+    int32_t GetHdiLaneId(const VibratorIdentifierIPC &identifier);
+    /** Queues the HDI call behind the ones already pending for the device and returns at once */
+    int32_t PostToHdiLane(const VibratorIdentifierIPC &identifier, std::function<void()> task);
+    /** Queues a stop without waiting for it, a full queue never drops it */
+    int32_t StopOnHdiLane(const VibratorIdentifierIPC &identifier, std::function<void()> task);
+    /** Runs the HDI call after the pending ones for the device, so a stop cannot overtake a queued play */
+    int32_t RunOnHdiLane(const VibratorIdentifierIPC &identifier, const std::function<void()> &task);
+    int64_t GetCurrentTimeMs();
     void MergeVibratorParmeters(const VibrateParameter &parameter, VibratePackage &package);
     bool CheckVibratorParmeters(const VibrateParameter &parameter);
     void RegisterClientDeathRecipient(sptr<IRemoteObject> vibratorServiceClient, int32_t pid);
@@ -146,6 +205,7 @@ private:
     void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
     int32_t SubscribeCommonEvent(const std::string &eventName, EventReceiver receiver);
     void OnReceiveEvent(const EventFwk::CommonEventData &data);
+    void OnReceivePackageRemovedEvent(const EventFwk::CommonEventData &data);
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
     void OnReceiveUserSwitchEvent(const EventFwk::CommonEventData &data);
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
@@ -155,20 +215,30 @@ private:
     int32_t PlayPrimitiveEffectCheckAuthAndParam(int32_t intensity, int32_t usage);
     int32_t PlayVibratorEffectCheckAuthAndParam(int32_t count, int32_t usage);
     int32_t GetHapticCapacityInfo(const VibratorIdentifierIPC& identifier, VibratorCapacity& capacityInfo);
-    int32_t GetAllWaveInfo(const VibratorIdentifierIPC& identifier, std::vector<HdfWaveInformation>& waveInfo);
+    int32_t GetAllWaveInfo(const VibratorIdentifierIPC& identifier, WaveInfosPtr& waveInfo);
     int32_t GetHapticStartUpTime(const VibratorIdentifierIPC& identifier, int32_t mode, int32_t &startUpTime);
+    std::map<int32_t, int32_t> QueryStartUpTimes(const VibratorIdentifierIPC& identifier,
+        const VibratorCapacity &capacity);
+    bool GetCachedStartUpTime(const VibratorIdentifierIPC& identifier, int32_t mode, int32_t &startUpTime);
     void GetOnlineVibratorInfo();
     std::vector<VibratorIdentifierIPC> CheckDeviceIdIsValid(const VibratorIdentifierIPC& identifier);
-    int32_t StartVibrateThreadControl(const VibratorIdentifierIPC& identifier, VibrateInfo& info);
+    /** @playback is built once per request and shared by every motor, the priority manager and the dump */
+    int32_t StartVibrateThreadControl(const VibratorIdentifierIPC& identifier, const VibrateInfoPtr &playback);
+    /** Queries the device's HDI directly, so it only runs on that device's lane */
     int32_t InsertVibratorInfo(int deviceId, const std::string &deviceName,
-        const std::vector<HdfVibratorInfo> &vibratorInfo);
+        const std::vector<HdfVibratorInfo> &vibratorInfo, const std::shared_ptr<std::promise<void>> &probe = nullptr);
+    void StartVibratorProbe(const HdfVibratorPlugInfo &info);
+    void ProbeVibratorDevice(const HdfVibratorPlugInfo &info, const std::shared_ptr<std::promise<void>> &probe);
+    bool IsCurrentProbe(int32_t deviceId, const std::shared_ptr<std::promise<void>> &probe);
+    /** Waits for the probe of the device, or for every pending probe when deviceId is -1 */
+    bool WaitVibratorProbe(int32_t deviceId);
     int32_t GetLocalDeviceId(int32_t &deviceId);
     int32_t GetOneVibrator(const VibratorIdentifierIPC& actIdentifier,
         std::vector<VibratorInfoIPC>& vibratorInfoIPC);
     void ConvertToServerInfos(const std::vector<HdfVibratorInfo> &baseVibratorInfo,
         const VibratorCapacity &vibratorCapacity, const std::vector<HdfWaveInformation> &waveInfomation,
         const HdfVibratorPlugInfo &info, VibratorAllInfos &vibratorAllInfos);
-    int32_t PerformVibrationControl(const VibratorIdentifierIPC& identifier, int32_t duration, VibrateInfo& info);
+    int32_t PerformVibrationControl(const VibratorIdentifierIPC& identifier, int32_t duration, VibrateInfo &&info);
     bool IsVibratorIdValid(const std::vector<VibratorInfoIPC> baseInfo, int32_t target);
     void ReportCallTimes();
     void SaveInvalidVibratorInfo(const std::string &pageName, int32_t invalidVibratorId);
@@ -196,18 +266,22 @@ private:
     std::vector<LightInfoIPC> lightInfos_;
     std::map<MiscdeviceDeviceId, bool> miscDeviceIdMap_;
     MiscdeviceServiceState state_;
-    std::mutex vibratorThreadMutex_;
+    PackageNameCache packageNameCache_;
     sptr<IRemoteObject::DeathRecipient> clientDeathObserver_ = nullptr;
     std::mutex clientDeathObserverMutex_;
-    static std::map<sptr<IRemoteObject>, int32_t> clientPidMap_;
+    static std::unordered_map<sptr<IRemoteObject>, int32_t, RemoteObjectHash> clientPidMap_;
     static std::mutex clientPidMapMutex_;
     std::mutex miscDeviceIdMapMutex_;
     std::mutex lightInfosMutex_;
-    static std::mutex devicesManageMutex_;
+    /** Read-mostly device index, written only on plug events and never held across HDI calls or IPC */
+    static std::shared_mutex devicesManageMutex_;
     static std::map<int32_t, VibratorAllInfos> devicesManageMap_;
-    int32_t invalidVibratorIdCount_ = 0;
-    std::vector<int32_t> disablePids_;
+    std::atomic_int32_t invalidVibratorIdCount_ = 0;
+    std::unordered_set<int32_t> disablePids_;
     std::mutex pidMutex_;
+    /** Taken after devicesManageMutex_ when both are needed */
+    std::mutex probeMutex_;
+    std::unordered_map<int32_t, VibratorProbe> vibratorProbes_;
     static std::atomic_bool deviceMute_;
     std::once_flag isRegistered_;
 };
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PACKAGE_NAME_CACHE_H
+#define PACKAGE_NAME_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace OHOS {
+namespace Sensors {
+/**
+ * Bounded LRU map from access token to package name. Tokens of a hap are only reused after the
+ * bundle is uninstalled, so entries stay valid until the removal event erases them.
+ */
+class PackageNameCache {
+public:
+    explicit PackageNameCache(size_t capacity);
+    ~PackageNameCache() = default;
+    bool Find(uint32_t tokenId, std::string &packageName);
+    void Insert(uint32_t tokenId, const std::string &packageName);
+    void Erase(uint32_t tokenId);
+    void Clear();
+    size_t Size();
+
+private:
+    using Entry = std::pair<uint32_t, std::string>;
+    size_t capacity_;
+    std::mutex cacheMutex_;
+    std::list<Entry> entries_;
+    std::unordered_map<uint32_t, std::list<Entry>::iterator> index_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // PACKAGE_NAME_CACHE_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLUG_EVENT_DISPATCHER_H
+#define PLUG_EVENT_DISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+
+namespace OHOS {
+namespace Sensors {
+struct VibratorPlugEvent {
+    int32_t status = 0;
+    int32_t deviceId = -1;
+    int32_t vibratorCnt = 0;
+    std::chrono::steady_clock::time_point postTime;
+};
+
+using PlugEventSink = std::function<void(const VibratorPlugEvent &)>;
+
+struct PlugEventStats {
+    size_t subscribers = 0;
+    size_t maxDepth = 0;
+    uint64_t published = 0;
+    uint64_t delivered = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+    uint64_t lagged = 0;
+    int64_t maxLagMs = 0;
+};
+
+/**
+ * Delivers plug events to subscribed clients from its own workers. Each client has a small queue in which
+ * a repeated state of the same device replaces the pending one, and a client is never served by two workers
+ * at once, so a slow client only delays itself.
+ */
+class PlugEventDispatcher : public Singleton<PlugEventDispatcher> {
+public:
+    PlugEventDispatcher() = default;
+    virtual ~PlugEventDispatcher();
+    void Subscribe(uintptr_t clientId, PlugEventSink sink);
+    void Unsubscribe(uintptr_t clientId);
+    void Publish(int32_t status, int32_t deviceId, int32_t vibratorCnt);
+    void Shutdown();
+    PlugEventStats GetStats();
+
+private:
+    struct Subscriber {
+        PlugEventSink sink;
+        std::deque<VibratorPlugEvent> events;
+        bool scheduled = false;
+        bool inFlight = false;
+    };
+    void Run();
+    std::mutex dispatchMutex_;
+    std::condition_variable dispatchCv_;
+    std::unordered_map<uintptr_t, std::shared_ptr<Subscriber>> subscribers_;
+    std::deque<uintptr_t> readyClients_;
+    std::vector<std::thread> workers_;
+    bool quit_ = false;
+    PlugEventStats stats_;
+};
+#define PlugDispatcher PlugEventDispatcher::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // PLUG_EVENT_DISPATCHER_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATE_COALESCER_H
+#define VIBRATE_COALESCER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "singleton.h"
+
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+constexpr int32_t DEFAULT_COALESCE_WINDOW = 20;
+constexpr int32_t MAX_COALESCE_DURATION = 50;
+
+struct VibrateCoalesceStats {
+    int32_t windowMs = 0;
+    uint64_t candidates = 0;
+    uint64_t merged = 0;
+};
+
+/**
+ * Remembers the last short preset started on each motor. A repeat of the same effect from the same caller
+ * that lands while that preset is still ramping is merged into it instead of restarting the motor,
+ * any other playback on the motor replaces the record.
+ */
+class VibrateCoalescer : public Singleton<VibrateCoalescer> {
+public:
+    VibrateCoalescer() = default;
+    virtual ~VibrateCoalescer() = default;
+    bool TryMerge(const VibratorIdentifierIPC &identifier, const VibrateInfo &info);
+    bool TryMerge(const VibratorIdentifierIPC &identifier, const VibrateInfo &info,
+        std::chrono::steady_clock::time_point now);
+    void Record(const VibratorIdentifierIPC &identifier, const VibrateInfo &info);
+    void Record(const VibratorIdentifierIPC &identifier, const VibrateInfo &info,
+        std::chrono::steady_clock::time_point now);
+    void Reset(const VibratorIdentifierIPC &identifier);
+    void SetWindow(int32_t windowMs);
+    VibrateCoalesceStats GetStats();
+
+private:
+    struct LastPreset {
+        std::string effect;
+        int32_t pid = -1;
+        int32_t usage = 0;
+        int32_t intensity = 0;
+        int32_t duration = 0;
+        std::chrono::steady_clock::time_point startTime;
+    };
+    bool IsCandidate(const VibrateInfo &info) const;
+    std::mutex coalesceMutex_;
+    int32_t windowMs_ = DEFAULT_COALESCE_WINDOW;
+    uint64_t candidates_ = 0;
+    uint64_t merged_ = 0;
+    std::map<std::pair<int32_t, int32_t>, LastPreset> lastPresets_;
+};
+#define Coalescer VibrateCoalescer::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATE_COALESCER_H
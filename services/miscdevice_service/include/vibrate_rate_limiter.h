@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATE_RATE_LIMITER_H
+#define VIBRATE_RATE_LIMITER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "singleton.h"
+
+#include "vibrator_agent_type.h"
+
+namespace OHOS {
+namespace Sensors {
+constexpr size_t MAX_RATE_BUCKETS = 256;
+
+/** A rate of zero leaves the usage unlimited */
+struct VibrateRateConfig {
+    uint32_t ratePerSecond = 0;
+    uint32_t burst = 0;
+};
+
+struct VibrateRateStats {
+    int32_t usage = USAGE_UNKNOWN;
+    VibrateRateConfig config;
+    uint64_t admitted = 0;
+    uint64_t rejected = 0;
+};
+
+struct VibrateRejectedCaller {
+    int32_t pid = -1;
+    int32_t uid = -1;
+    int32_t usage = USAGE_UNKNOWN;
+    uint64_t rejected = 0;
+};
+
+/**
+ * Token bucket per calling pid and usage, consulted after a request is validated and before it touches the
+ * device table, so a flooding client is turned away without contending with other callers. Every usage is
+ * unlimited until a limit is configured.
+ */
+class VibrateRateLimiter : public Singleton<VibrateRateLimiter> {
+public:
+    VibrateRateLimiter() = default;
+    virtual ~VibrateRateLimiter() = default;
+    bool TryAcquire(int32_t pid, int32_t uid, int32_t usage);
+    bool TryAcquire(int32_t pid, int32_t uid, int32_t usage, std::chrono::steady_clock::time_point now);
+    void SetRateConfig(int32_t usage, const VibrateRateConfig &config);
+    void Erase(int32_t pid);
+    std::vector<VibrateRateStats> GetStats();
+    std::vector<VibrateRejectedCaller> GetRejectedCallers();
+    size_t GetBucketCount();
+
+private:
+    struct Bucket {
+        int32_t uid = -1;
+        double tokens = 0;
+        std::chrono::steady_clock::time_point lastRefill;
+        std::chrono::steady_clock::time_point lastUsed;
+        uint64_t rejected = 0;
+    };
+    void Refill(Bucket &bucket, const VibrateRateConfig &config, std::chrono::steady_clock::time_point now);
+    void EvictIdleBuckets(std::chrono::steady_clock::time_point now);
+    void EvictLeastRecentBucket();
+    std::mutex limiterMutex_;
+    std::array<VibrateRateConfig, USAGE_MAX> configs_ {};
+    std::array<uint64_t, USAGE_MAX> admitted_ {};
+    std::array<uint64_t, USAGE_MAX> rejected_ {};
+    std::unordered_map<uint64_t, Bucket> buckets_;
+};
+#define RateLimiter VibrateRateLimiter::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATE_RATE_LIMITER_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATION_OWNER_INDEX_H
+#define VIBRATION_OWNER_INDEX_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "singleton.h"
+
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+struct OwnedVibration {
+    VibratorIdentifierIPC identifier;
+    /** The HD haptic session playing on the motor, 0 when the playback has none */
+    uint32_t sessionId = 0;
+};
+
+/**
+ * Reverse index from a calling pid to the motors whose current playback it started. Every motor has at most
+ * one owner, so the index stays bounded by the motor count and a client death only visits what it owned.
+ */
+class VibrationOwnerIndex : public Singleton<VibrationOwnerIndex> {
+public:
+    VibrationOwnerIndex() = default;
+    virtual ~VibrationOwnerIndex() = default;
+    void Bind(int32_t pid, const VibratorIdentifierIPC &identifier, uint32_t sessionId = 0);
+    /** Returns whether the motor had an owner */
+    bool Unbind(const VibratorIdentifierIPC &identifier);
+    /** Unbinds the motor only while the given session is still its current playback */
+    bool UnbindSession(const VibratorIdentifierIPC &identifier, uint32_t sessionId);
+    std::vector<OwnedVibration> Release(int32_t pid);
+    size_t GetOwnerCount();
+
+private:
+    struct MotorOwner {
+        int32_t pid = 0;
+        uint32_t sessionId = 0;
+    };
+    static uint64_t GetMotorKey(int32_t deviceId, int32_t vibratorId);
+    bool UnbindLocked(uint64_t motorKey);
+    std::mutex ownerMutex_;
+    std::unordered_map<uint64_t, MotorOwner> motorOwners_;
+    std::unordered_map<int32_t, std::unordered_set<uint64_t>> ownedMotors_;
+};
+#define OwnerIndex VibrationOwnerIndex::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATION_OWNER_INDEX_H
@@ -101,7 +101,7 @@ private:
     bool IsCurrentVibrate(const std::shared_ptr<VibratorThread> &vibratorThread,
         const VibratorIdentifierIPC& identifier) const;
     bool IsLoopVibrate(const VibrateInfo &vibrateInfo) const;
-    VibrateStatus ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo, VibrateInfo currentVibrateInfo) const;
+    VibrateStatus ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo, const VibrateInfo &currentVibrateInfo) const;
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
     bool ShouldIgnoreInputMethod(const VibrateInfo &vibrateInfo);
     void UpdateInputMethodBundleNames();
@@ -171,4 +171,4 @@ private:
 #define PriorityManager DelayedSingleton<VibrationPriorityManager>::GetInstance()
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // VIBRATION_PRIORITY_MANAGER_H
\ No newline at end of file
+#endif  // VIBRATION_PRIORITY_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATOR_CLOCK_H
+#define VIBRATOR_CLOCK_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace OHOS {
+namespace Sensors {
+/**
+ * Time source of the playback engine. Every timeline deadline and every timed wait of a vibrate worker goes
+ * through it, so a virtual implementation can run a whole timeline without sleeping.
+ */
+class VibratorClock {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    virtual ~VibratorClock() = default;
+    virtual TimePoint Now() = 0;
+    /** Blocks on @cv until @pred holds or @deadline passes, returns the final value of @pred */
+    virtual bool WaitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TimePoint deadline,
+        const std::function<bool()> &pred) = 0;
+    virtual void SleepFor(std::chrono::microseconds duration) = 0;
+    static std::shared_ptr<VibratorClock> GetSteadyClock();
+};
+
+class SteadyVibratorClock : public VibratorClock {
+public:
+    SteadyVibratorClock() = default;
+    ~SteadyVibratorClock() override = default;
+    TimePoint Now() override;
+    bool WaitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TimePoint deadline,
+        const std::function<bool()> &pred) override;
+    void SleepFor(std::chrono::microseconds duration) override;
+};
+
+/**
+ * Virtual time for tests. A wait whose predicate does not hold jumps the clock straight to its deadline, so
+ * timelines finish instantly and every dispatch lands exactly on its scheduled time.
+ */
+class VirtualVibratorClock : public VibratorClock {
+public:
+    VirtualVibratorClock();
+    ~VirtualVibratorClock() override = default;
+    TimePoint Now() override;
+    bool WaitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TimePoint deadline,
+        const std::function<bool()> &pred) override;
+    void SleepFor(std::chrono::microseconds duration) override;
+    void Advance(std::chrono::microseconds duration);
+
+private:
+    void AdvanceTo(TimePoint timePoint);
+    std::mutex nowMutex_;
+    TimePoint now_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATOR_CLOCK_H
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATOR_EFFECT_CATALOG_H
+#define VIBRATOR_EFFECT_CATALOG_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "singleton.h"
+
+#include "i_vibrator_hdi_connection.h"
+
+namespace OHOS {
+namespace Sensors {
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+struct EffectCatalogStats {
+    int32_t deviceId = -1;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    std::vector<std::pair<std::string, HdfEffectInfo>> effects;
+};
+
+/**
+ * Preset effect support and duration per device, filled on first query and dropped on plug events,
+ * so repeated preset requests are answered from memory instead of the HDI. Only devices added from
+ * the device table are cached, lookups for any other id neither hit nor grow the catalog.
+ */
+class VibratorEffectCatalog : public Singleton<VibratorEffectCatalog> {
+public:
+    VibratorEffectCatalog() = default;
+    virtual ~VibratorEffectCatalog() = default;
+    void AddDevice(int32_t deviceId);
+    std::optional<HdfEffectInfo> Find(int32_t deviceId, const std::string &effect);
+    void Insert(int32_t deviceId, const std::string &effect, const HdfEffectInfo &effectInfo);
+    void Erase(int32_t deviceId);
+    std::vector<EffectCatalogStats> GetStats();
+
+private:
+    struct DeviceEffects {
+        std::map<std::string, HdfEffectInfo> effects;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    std::mutex catalogMutex_;
+    std::map<int32_t, DeviceEffects> catalog_;
+};
+#define EffectCatalog VibratorEffectCatalog::GetInstance()
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATOR_EFFECT_CATALOG_H
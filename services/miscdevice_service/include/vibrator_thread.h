@@ -16,51 +16,155 @@
 #ifndef VIBRATOR_THREAD_H
 #define VIBRATOR_THREAD_H
 
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
 #include <thread>
 
 #include "thread_ex.h"
 
+#include "vibrator_clock.h"
 #include "vibrator_hdi_connection.h"
 
 namespace OHOS {
 namespace Sensors {
+using WaveInfosPtr = std::shared_ptr<const std::vector<HdfWaveInformation>>;
+
+/**
+ * Motors started by one request share a group, every worker waits for the same monotonic start time and
+ * reports how late it actually started so the inter-motor skew can be measured.
+ */
+class PlaybackGroup {
+public:
+    PlaybackGroup(std::chrono::steady_clock::time_point startTime, size_t motorCount);
+    ~PlaybackGroup() = default;
+    std::chrono::steady_clock::time_point GetStartTime() const;
+    void ReportStart(int32_t vibratorId, int64_t latenessUs);
+    /** Filled by the service before the group reaches any worker, read-only afterwards */
+    void AddPartition(int32_t position, VibratePackage &&package);
+    const VibratePackage *GetPartition(int32_t position) const;
+
+private:
+    std::chrono::steady_clock::time_point startTime_;
+    std::map<int32_t, VibratePackage> partitions_;
+    size_t motorCount_ = 0;
+    std::mutex reportMutex_;
+    size_t startedCount_ = 0;
+    int64_t minLatenessUs_ = 0;
+    int64_t maxLatenessUs_ = 0;
+};
+
+enum class VibratorCommandType {
+    PLAY = 0,
+    PREEMPT,
+    STOP,
+};
+
+struct VibratorCommand {
+    VibratorCommandType type = VibratorCommandType::PLAY;
+    uint64_t generation = 0;
+    VibrateInfoPtr info;
+    VibratorIdentifierIPC identifier;
+    WaveInfosPtr waveInfos;
+    std::shared_ptr<PlaybackGroup> group;
+    std::chrono::steady_clock::time_point postTime;
+};
+
+/**
+ * Long-lived playback worker owned by one motor. The worker thread is started on the first request and then
+ * sleeps on a command queue, a new request preempts the current playback instead of restarting the thread.
+ */
 class VibratorThread : public Thread {
 public:
-    void UpdateVibratorEffect(const VibrateInfo &vibrateInfo, const VibratorIdentifierIPC& identifier,
-        std::vector<HdfWaveInformation> &waveInfos);
-    VibrateInfo GetCurrentVibrateInfo();
-    std::vector<HdfWaveInformation> GetCurrentWaveInfo();
-    void SetExitStatus(bool status);
-    void NotifyExit();
-    void ResetVibrateInfo();
+    VibratorThread();
+    ~VibratorThread() override;
+    void Play(const VibrateInfoPtr &info, const VibratorIdentifierIPC& identifier, const WaveInfosPtr &waveInfos,
+        const std::shared_ptr<PlaybackGroup> &group = nullptr);
+    void Stop();
+    void UpdateVibratorEffect(const VibrateInfoPtr &vibrateInfo, const VibratorIdentifierIPC& identifier,
+        const WaveInfosPtr &waveInfos);
+    VibrateInfoPtr GetCurrentVibrateInfo();
+    WaveInfosPtr GetCurrentWaveInfo();
+    bool IsPlaying() const;
+    /** Replaces the time source, only allowed before the worker starts */
+    bool SetClock(const std::shared_ptr<VibratorClock> &clock);
+    /** Current time of the worker's clock, group start times must be taken from it */
+    VibratorClock::TimePoint Now();
+    /** Start-up delay of the actuator per vibrate mode, captured once when the device is inserted */
+    void SetStartUpTimes(const std::map<int32_t, int32_t> &startUpTimes);
+    static VibratePackage copyPackageWithIndexEvents(const VibratePackage& originalPackage,
+        const VibratorIdentifierIPC& identifier);
 protected:
     virtual bool Run();
 
 private:
+    bool StartWorker();
+    uint64_t PostCommand(VibratorCommand &&command);
+    bool WaitForExit(int32_t delayTime);
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+    void UpdateDispatchCost(int64_t costUs);
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    size_t StageHapticPakets(const std::vector<VibratePattern> &patterns, size_t begin,
+        std::deque<HapticPaket> &stagedPakets);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+    void ExecuteCommand(const VibratorCommand &command);
+    int32_t PlayVibration(const VibratorCommand &command);
+    void FinishCommand(uint64_t generation);
+    void ResetVibrateInfo();
     VibratorIdentifierIPC GetCurrentVibrateParams();
     int32_t PlayOnce(const VibrateInfo &info, const VibratorIdentifierIPC& identifier);
     int32_t PlayEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier);
     int32_t PlayCustomByHdHptic(const VibrateInfo &info, const VibratorIdentifierIPC& identifier);
     void HandleMultipleVibrations(const VibratorIdentifierIPC& identifier);
-    VibrateInfo copyInfoWithIndexEvents(const VibrateInfo& originalInfo, const VibratorIdentifierIPC& identifier);
+    void MarkMotorBusy(int32_t duration);
+    void MarkMotorIdle();
+    int32_t RunHdi(const VibratorIdentifierIPC& identifier, const std::function<int32_t()> &call);
+    bool IsMotorRunning(const VibratorIdentifierIPC& identifier);
+    void StopMotor(const VibratorIdentifierIPC& identifier, HdfVibratorMode mode);
+    bool IsPreempted();
+    void StopAbortedPlayback(const VibratorIdentifierIPC& identifier, HdfVibratorMode mode);
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
     int32_t PlayCustomByCompositeEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier,
-        const std::vector<HdfWaveInformation> &waveInfo);
+        const std::vector<HdfWaveInformation> &waveInfo, const VibratePackage *partition);
     int32_t PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect,
         const VibratorIdentifierIPC& identifier);
+    bool BuildCompositeEffectPart(const HdfCompositeEffect &hdfCompositeEffect, size_t &cursor,
+        HdfCompositeEffect &effectsPart, int32_t &delayTime);
+    int32_t GetCompositeStartUpTime(const VibratorIdentifierIPC& identifier, int32_t effectType);
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
 #ifdef OHOS_BUILD_ENABLE_QOS
     void SetQosForThread();
 #endif // OHOS_BUILD_ENABLE_QOS
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+    void SetRealTimeProfile();
+    void SetThreadAffinity(const std::string &cpus);
+    void LockThreadStack();
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+    std::mutex startUpTimesMutex_;
+    std::map<int32_t, int32_t> startUpTimes_;
     std::mutex currentVibrationMutex_;
-    VibrateInfo currentVibration_;
-    std::vector<HdfWaveInformation> waveInfos_;
+    VibrateInfoPtr currentVibration_;
+    WaveInfosPtr waveInfos_;
     VibratorIdentifierIPC currentVibrateParams_;
     std::mutex vibrateMutex_;
     std::condition_variable cv_;
     std::atomic<bool> exitFlag_ = false;
+    std::mutex commandMutex_;
+    std::condition_variable commandCv_;
+    std::condition_variable idleCv_;
+    std::deque<VibratorCommand> commandQueue_;
+    uint64_t generation_ = 0;
+    bool quit_ = false;
+    std::atomic<bool> playing_ = false;
+    std::mutex workerMutex_;
+    bool workerInitialized_ = false;
+    int64_t dispatchCostUs_ = 0;
+    bool motorStateKnown_ = false;
+    std::chrono::steady_clock::time_point motorIdleAt_;
+    std::shared_ptr<VibratorClock> clock_ = VibratorClock::GetSteadyClock();
 };
 #define VibratorDevice VibratorHdiConnection::GetInstance()
 }  // namespace Sensors
 }  // namespace OHOS
-#endif  // VIBRATOR_THREAD_H
\ No newline at end of file
+#endif  // VIBRATOR_THREAD_H
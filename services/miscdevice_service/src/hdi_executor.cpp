@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hdi_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <sys/prctl.h>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HdiExecutor"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr size_t HDI_EXECUTOR_QUEUE_CAPACITY = 32;
+constexpr int32_t HDI_EXECUTOR_WAIT_TIMEOUT = 500;  /** ms */
+const std::string HDI_EXECUTOR_THREAD_NAME = "OS_MiscHdiExec";
+}  // namespace
+
+HdiExecutor::~HdiExecutor()
+{
+    Shutdown();
+}
+
+void HdiExecutor::Add(HdiDomain domain, int32_t deviceId)
+{
+    std::lock_guard<std::mutex> lock(lanesMutex_);
+    auto &lane = lanes_[std::make_pair(domain, deviceId)];
+    if (lane == nullptr) {
+        lane = std::make_shared<Lane>();
+        lane->worker = std::thread(HdiExecutor::RunLane, lane);
+    }
+}
+
+std::shared_ptr<HdiExecutor::Lane> HdiExecutor::GetLane(HdiDomain domain, int32_t deviceId)
+{
+    std::lock_guard<std::mutex> lock(lanesMutex_);
+    auto it = lanes_.find(std::make_pair(domain, deviceId));
+    return (it == lanes_.end()) ? nullptr : it->second;
+}
+
+bool HdiExecutor::Post(HdiDomain domain, int32_t deviceId, std::function<void()> task, bool urgent)
+{
+    std::shared_ptr<Lane> lane = GetLane(domain, deviceId);
+    if (lane == nullptr) {
+        MISC_HILOGE("HDI queue not found, domain:%{public}d, deviceId:%{public}d", domain, deviceId);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> laneLock(lane->laneMutex);
+        if (lane->quit || (!urgent && (lane->tasks.size() >= HDI_EXECUTOR_QUEUE_CAPACITY))) {
+            ++lane->rejected;
+            MISC_HILOGE("HDI queue is full, domain:%{public}d, deviceId:%{public}d", domain, deviceId);
+            return false;
+        }
+        lane->tasks.push_back(std::move(task));
+        lane->maxDepth = std::max(lane->maxDepth, lane->tasks.size());
+    }
+    lane->laneCv.notify_one();
+    return true;
+}
+
+bool HdiExecutor::PostAndWait(HdiDomain domain, int32_t deviceId, std::function<void()> task)
+{
+    auto state = std::make_shared<std::atomic<int32_t>>(TASK_PENDING);
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> finished = done->get_future();
+    bool posted = Post(domain, deviceId, [task = std::move(task), state, done]() {
+        int32_t pending = TASK_PENDING;
+        if (state->compare_exchange_strong(pending, TASK_RUNNING)) {
+            task();
+        }
+        done->set_value();
+    });
+    if (!posted) {
+        return false;
+    }
+    if (finished.wait_for(std::chrono::milliseconds(HDI_EXECUTOR_WAIT_TIMEOUT)) == std::future_status::ready) {
+        return true;
+    }
+    /** A task that already started is one HDI call away from done, only a queued one can be dropped safely */
+    int32_t pending = TASK_PENDING;
+    if (state->compare_exchange_strong(pending, TASK_CANCELLED)) {
+        MISC_HILOGE("HDI call timed out, domain:%{public}d, deviceId:%{public}d", domain, deviceId);
+        return false;
+    }
+    finished.wait();
+    return true;
+}
+
+void HdiExecutor::RunLane(std::shared_ptr<Lane> lane)
+{
+    prctl(PR_SET_NAME, HDI_EXECUTOR_THREAD_NAME.c_str());
+    std::unique_lock<std::mutex> laneLock(lane->laneMutex);
+    while (true) {
+        lane->laneCv.wait(laneLock, [&lane] { return lane->quit || !lane->tasks.empty(); });
+        if (lane->tasks.empty()) {
+            break;
+        }
+        std::function<void()> task = std::move(lane->tasks.front());
+        lane->tasks.pop_front();
+        laneLock.unlock();
+        task();
+        laneLock.lock();
+        ++lane->executed;
+    }
+}
+
+void HdiExecutor::StopLane(const std::shared_ptr<Lane> &lane)
+{
+    {
+        std::lock_guard<std::mutex> laneLock(lane->laneMutex);
+        lane->quit = true;
+    }
+    lane->laneCv.notify_one();
+    if (lane->worker.joinable()) {
+        lane->worker.join();
+    }
+}
+
+void HdiExecutor::Remove(HdiDomain domain, int32_t deviceId)
+{
+    std::shared_ptr<Lane> lane = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(lanesMutex_);
+        auto it = lanes_.find(std::make_pair(domain, deviceId));
+        if (it == lanes_.end()) {
+            return;
+        }
+        lane = it->second;
+        lanes_.erase(it);
+    }
+    StopLane(lane);
+}
+
+void HdiExecutor::Shutdown()
+{
+    std::map<LaneKey, std::shared_ptr<Lane>> lanes;
+    {
+        std::lock_guard<std::mutex> lock(lanesMutex_);
+        lanes.swap(lanes_);
+    }
+    for (const auto &[key, lane] : lanes) {
+        StopLane(lane);
+    }
+}
+
+std::vector<HdiExecutorStats> HdiExecutor::GetStats()
+{
+    std::lock_guard<std::mutex> lock(lanesMutex_);
+    std::vector<HdiExecutorStats> stats;
+    for (const auto &[key, lane] : lanes_) {
+        std::lock_guard<std::mutex> laneLock(lane->laneMutex);
+        HdiExecutorStats laneStats;
+        laneStats.domain = key.first;
+        laneStats.deviceId = key.second;
+        laneStats.depth = lane->tasks.size();
+        laneStats.maxDepth = lane->maxDepth;
+        laneStats.executed = lane->executed;
+        laneStats.rejected = lane->rejected;
+        stats.push_back(laneStats);
+    }
+    return stats;
+}
+}  // namespace Sensors
+}  // namespace OHOS
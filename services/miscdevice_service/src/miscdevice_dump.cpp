@@ -15,12 +15,20 @@
 
 #include "miscdevice_dump.h"
 
+#include <cinttypes>
 #include <getopt.h>
 
+#include <algorithm>
 #include <map>
 
+#include "hdi_executor.h"
+#include "plug_event_dispatcher.h"
+#include "permission_util.h"
 #include "securec.h"
 #include "sensors_errors.h"
+#include "vibrate_coalescer.h"
+#include "vibrate_rate_limiter.h"
+#include "vibrator_effect_catalog.h"
 
 #undef LOG_TAG
 #define LOG_TAG "MiscdeviceDump"
@@ -33,6 +41,7 @@ constexpr uint32_t BASE_YEAR = 1900;
 constexpr uint32_t BASE_MON = 1;
 constexpr int32_t MAX_DUMP_PARAMETERS = 32;
 constexpr int32_t CONVERSION_RATE = 1000;
+const std::array<std::string, WAKEUP_SOURCE_MAX> WAKEUP_SOURCE_NAMES = { "command", "timer" };
 }  // namespace
 
 static std::map<int32_t, std::string> usageMap_ = {
@@ -102,17 +111,52 @@ void MiscdeviceDump::RunVibratorDump(int32_t fd, int32_t optionIndex, const std:
 {
     struct option dumpOptions[] = {
         {"record", no_argument, 0, 'r'},
+        {"wakeup", no_argument, 0, 'w'},
+        {"permission", no_argument, 0, 'p'},
+        {"effect", no_argument, 0, 'e'},
+        {"limit", no_argument, 0, 'l'},
+        {"coalesce", no_argument, 0, 'c'},
+        {"queue", no_argument, 0, 'q'},
+        {"notify", no_argument, 0, 'n'},
         {"help", no_argument, 0, 'h'},
         {NULL, 0, 0, 0}
     };
     optind = 1;
     int32_t c;
-    while ((c = getopt_long(args.size(), argv, "rh", dumpOptions, &optionIndex)) != -1) {
+    while ((c = getopt_long(args.size(), argv, "rwpelcqnh", dumpOptions, &optionIndex)) != -1) {
         switch (c) {
             case 'r': {
                 DumpMiscdeviceRecord(fd);
                 break;
             }
+            case 'w': {
+                DumpWakeupLatency(fd);
+                break;
+            }
+            case 'p': {
+                DumpPermissionVerdicts(fd);
+                break;
+            }
+            case 'e': {
+                DumpEffectCatalog(fd);
+                break;
+            }
+            case 'l': {
+                DumpRateLimiter(fd);
+                break;
+            }
+            case 'c': {
+                DumpCoalescer(fd);
+                break;
+            }
+            case 'q': {
+                DumpHdiExecutor(fd);
+                break;
+            }
+            case 'n': {
+                DumpPlugEvent(fd);
+                break;
+            }
             case 'h': {
                 DumpHelp(fd);
                 break;
@@ -130,6 +174,13 @@ void MiscdeviceDump::DumpHelp(int32_t fd)
     dprintf(fd, "Usage:\n");
     dprintf(fd, "      -h, --help: dump help\n");
     dprintf(fd, "      -r, --record: dump the list of vibrate recorded\n");
+    dprintf(fd, "      -w, --wakeup: dump the wakeup-to-run latency histogram of vibrate workers\n");
+    dprintf(fd, "      -p, --permission: dump the hit and miss counters of cached permission verdicts\n");
+    dprintf(fd, "      -e, --effect: dump the preset effects cached per vibrator device\n");
+    dprintf(fd, "      -l, --limit: dump the vibrate requests admitted and rejected by the rate limiter\n");
+    dprintf(fd, "      -c, --coalesce: dump how many short presets were merged into the one already playing\n");
+    dprintf(fd, "      -q, --queue: dump the depth of the HDI queue of every device\n");
+    dprintf(fd, "      -n, --notify: dump the delivery counters of plug event notifications\n");
 }
 
 void MiscdeviceDump::DumpMiscdeviceRecord(int32_t fd)
@@ -144,34 +195,42 @@ void MiscdeviceDump::DumpMiscdeviceRecord(int32_t fd)
         auto record = dumpQueue_.front();
         dumpQueue_.push(record);
         dumpQueue_.pop();
-        VibrateInfo info = record.info;
-        if (info.mode == "time") {
+        if (record.info == nullptr) {
+            continue;
+        }
+        const VibrateInfo &info = *record.info;
+        std::string startTime = FormatTime(record.startTimeMs);
+        if (info.mode == VIBRATE_TIME) {
             dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | duration:%d | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
+                startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
                 info.duration, GetUsageName(info.usage).c_str());
-        } else if (info.mode == "preset") {
+        } else if (info.mode == VIBRATE_PRESET) {
             dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | effect:%s | count:%d | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
+                startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
                 info.effect.c_str(), info.count, GetUsageName(info.usage).c_str());
         } else {
-            dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
-                GetUsageName(info.usage).c_str());
+            dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | mode:%s | usage:%s\n",
+                startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
+                GetVibrateModeName(info.mode).c_str(), GetUsageName(info.usage).c_str());
         }
     }
 }
 
-void MiscdeviceDump::DumpCurrentTime(std::string &startTime)
+std::string MiscdeviceDump::FormatTime(int64_t timeMs)
 {
-    timespec curTime;
-    clock_gettime(CLOCK_REALTIME, &curTime);
-    struct tm *timeinfo = localtime(&(curTime.tv_sec));
-    CHKPV(timeinfo);
-    startTime.append(std::to_string(timeinfo->tm_year + BASE_YEAR)).append("-")
-        .append(std::to_string(timeinfo->tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo->tm_mday))
-        .append(" ").append(std::to_string(timeinfo->tm_hour)).append(":").append(std::to_string(timeinfo->tm_min))
-        .append(":").append(std::to_string(timeinfo->tm_sec)).append(".")
-        .append(std::to_string(curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE)));
+    std::string startTime;
+    time_t seconds = static_cast<time_t>(timeMs / CONVERSION_RATE);
+    struct tm timeinfo;
+    if (localtime_r(&seconds, &timeinfo) == nullptr) {
+        MISC_HILOGE("localtime_r failed");
+        return startTime;
+    }
+    startTime.append(std::to_string(timeinfo.tm_year + BASE_YEAR)).append("-")
+        .append(std::to_string(timeinfo.tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo.tm_mday))
+        .append(" ").append(std::to_string(timeinfo.tm_hour)).append(":").append(std::to_string(timeinfo.tm_min))
+        .append(":").append(std::to_string(timeinfo.tm_sec)).append(".")
+        .append(std::to_string(timeMs % CONVERSION_RATE));
+    return startTime;
 }
 
 void MiscdeviceDump::UpdateRecordQueue(const VibrateRecord &record)
@@ -183,14 +242,117 @@ void MiscdeviceDump::UpdateRecordQueue(const VibrateRecord &record)
     }
 }
 
-void MiscdeviceDump::SaveVibrateRecord(const VibrateInfo &vibrateInfo)
+void MiscdeviceDump::SaveVibrateRecord(const VibrateInfoPtr &vibrateInfo)
 {
     VibrateRecord record;
     record.info = vibrateInfo;
-    DumpCurrentTime(record.startTime);
+    timespec curTime;
+    clock_gettime(CLOCK_REALTIME, &curTime);
+    record.startTimeMs = static_cast<int64_t>(curTime.tv_sec) * CONVERSION_RATE +
+        curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE);
     UpdateRecordQueue(record);
 }
 
+void MiscdeviceDump::DumpWakeupLatency(int32_t fd)
+{
+    for (size_t source = 0; source < WAKEUP_SOURCE_MAX; ++source) {
+        uint64_t total = 0;
+        for (const auto &bucket : wakeupLatency_[source]) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        dprintf(fd, "%s wakeups:%" PRIu64 " | max:%" PRId64 "us\n", WAKEUP_SOURCE_NAMES[source].c_str(), total,
+            maxWakeupLatencyUs_[source].load(std::memory_order_relaxed));
+        for (size_t i = 0; i < WAKEUP_LATENCY_BUCKETS; ++i) {
+            uint64_t count = wakeupLatency_[source][i].load(std::memory_order_relaxed);
+            if (count == 0) {
+                continue;
+            }
+            if (i + 1 == WAKEUP_LATENCY_BUCKETS) {
+                dprintf(fd, "    >=%" PRId64 "us: %" PRIu64 "\n", static_cast<int64_t>(1) << (i - 1), count);
+            } else {
+                dprintf(fd, "    <%" PRId64 "us: %" PRIu64 "\n", static_cast<int64_t>(1) << i, count);
+            }
+        }
+    }
+}
+
+void MiscdeviceDump::DumpPermissionVerdicts(int32_t fd)
+{
+    PermissionVerdictStats stats = PermissionUtil::GetInstance().GetVerdictStats();
+    dprintf(fd, "permission verdicts cached:%zu | hits:%" PRIu64 " | misses:%" PRIu64 "\n", stats.size,
+        stats.hits, stats.misses);
+}
+
+void MiscdeviceDump::DumpEffectCatalog(int32_t fd)
+{
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    for (const auto &stats : EffectCatalog.GetStats()) {
+        dprintf(fd, "deviceId:%d | effects:%zu | hits:%" PRIu64 " | misses:%" PRIu64 "\n", stats.deviceId,
+            stats.effects.size(), stats.hits, stats.misses);
+        for (const auto &[effect, effectInfo] : stats.effects) {
+            dprintf(fd, "    %s | supported:%d | duration:%d\n", effect.c_str(), effectInfo.isSupportEffect,
+                effectInfo.duration);
+        }
+    }
+#else
+    dprintf(fd, "Effect catalog is not supported\n");
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+}
+
+void MiscdeviceDump::DumpRateLimiter(int32_t fd)
+{
+    for (const auto &stats : RateLimiter.GetStats()) {
+        dprintf(fd, "usage:%s | rate:%u/s | burst:%u | admitted:%" PRIu64 " | rejected:%" PRIu64 "\n",
+            GetUsageName(stats.usage).c_str(), stats.config.ratePerSecond, stats.config.burst, stats.admitted,
+            stats.rejected);
+    }
+    for (const auto &caller : RateLimiter.GetRejectedCallers()) {
+        dprintf(fd, "    pid:%d | uid:%d | usage:%s | rejected:%" PRIu64 "\n", caller.pid, caller.uid,
+            GetUsageName(caller.usage).c_str(), caller.rejected);
+    }
+}
+
+void MiscdeviceDump::DumpCoalescer(int32_t fd)
+{
+    VibrateCoalesceStats stats = Coalescer.GetStats();
+    double ratio = (stats.candidates == 0) ? 0.0 : static_cast<double>(stats.merged) / stats.candidates;
+    dprintf(fd, "coalesce window:%dms | candidates:%" PRIu64 " | merged:%" PRIu64 " | merge ratio:%.3f\n",
+        stats.windowMs, stats.candidates, stats.merged, ratio);
+}
+
+void MiscdeviceDump::DumpHdiExecutor(int32_t fd)
+{
+    for (const auto &stats : HdiExecutorPool.GetStats()) {
+        dprintf(fd, "%s:%d | depth:%zu | max depth:%zu | executed:%" PRIu64 " | rejected:%" PRIu64 "\n",
+            (stats.domain == HDI_DOMAIN_LIGHT) ? "light" : "vibrator", stats.deviceId, stats.depth, stats.maxDepth,
+            stats.executed, stats.rejected);
+    }
+}
+
+void MiscdeviceDump::DumpPlugEvent(int32_t fd)
+{
+    PlugEventStats stats = PlugDispatcher.GetStats();
+    dprintf(fd, "subscribers:%zu | max depth:%zu | published:%" PRIu64 " | delivered:%" PRIu64 " | coalesced:%" PRIu64
+        " | dropped:%" PRIu64 " | lagged:%" PRIu64 " | max lag:%" PRId64 "ms\n", stats.subscribers, stats.maxDepth,
+        stats.published, stats.delivered, stats.coalesced, stats.dropped, stats.lagged, stats.maxLagMs);
+}
+
+void MiscdeviceDump::SaveWakeupLatency(WakeupSource source, int64_t latencyUs)
+{
+    if (source < 0 || source >= WAKEUP_SOURCE_MAX) {
+        return;
+    }
+    latencyUs = std::max<int64_t>(latencyUs, 0);
+    size_t bucket = 0;
+    while (bucket + 1 < WAKEUP_LATENCY_BUCKETS && (static_cast<int64_t>(1) << bucket) <= latencyUs) {
+        ++bucket;
+    }
+    wakeupLatency_[source][bucket].fetch_add(1, std::memory_order_relaxed);
+    int64_t maxLatency = maxWakeupLatencyUs_[source].load(std::memory_order_relaxed);
+    while (latencyUs > maxLatency &&
+        !maxWakeupLatencyUs_[source].compare_exchange_weak(maxLatency, latencyUs, std::memory_order_relaxed)) {}
+}
+
 std::string MiscdeviceDump::GetUsageName(int32_t usage)
 {
     auto it = usageMap_.find(usage);
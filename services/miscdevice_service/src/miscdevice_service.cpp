@@ -15,9 +15,12 @@
 
 #include "miscdevice_service.h"
 
-#ifdef OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
+#include <algorithm>
+#include <cinttypes>
+#include <future>
+#include <set>
+
 #include "common_event_support.h"
-#endif // OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
 #include "death_recipient_template.h"
 #ifdef HIVIEWDFX_HISYSEVENT_ENABLE
 #include "hisysevent.h"
@@ -66,21 +69,38 @@ constexpr int32_t INTENSITY_ADJUST_MAX = 100;
 constexpr int32_t FREQUENCY_ADJUST_MIN = -100;
 constexpr int32_t FREQUENCY_ADJUST_MAX = 100;
 constexpr int32_t INVALID_PID = -1;
-constexpr int32_t BASE_YEAR = 1900;
-constexpr int32_t BASE_MON = 1;
+constexpr size_t PACKAGE_NAME_CACHE_CAPACITY = 64;
+const std::string ACCESS_TOKEN_ID = "accessTokenId";
 constexpr int32_t CONVERSION_RATE = 1000;
 constexpr int32_t HOURS_IN_DAY = 24;
 constexpr int32_t MINUTES_IN_HOUR = 60;
 constexpr int32_t SECONDS_IN_MINUTE = 60;
 constexpr uint32_t MAX_SUPPORT_CLIENT_NUM = 1024;
+constexpr int32_t PROBE_WAIT_TIMEOUT = 200; // ms
+const WaveInfosPtr EMPTY_WAVE_INFOS = std::make_shared<const std::vector<HdfWaveInformation>>();
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 const std::string PHONE_TYPE = "phone";
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
 constexpr int32_t SHORT_VIBRATOR_DURATION = 50;
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
+constexpr int32_t GROUP_START_LEAD_TIME = 5; // ms
 constexpr int32_t LOG_COUNT_FIVE = 5;
 const inline char *DEVICE_MUTE_FLAG = "vendor.device.vibrator.mute";
+/** Per-usage limits, e.g. const.miscdevice.vibrator.rate_limit.5 for USAGE_TOUCH; unset means unlimited */
+const std::string RATE_LIMIT_PARAM = "const.miscdevice.vibrator.rate_limit.";
+const std::string RATE_BURST_PARAM = "const.miscdevice.vibrator.rate_burst.";
+constexpr uint32_t MAX_RATE_LIMIT = 10000;
+
+VibratorTarget BuildVibratorTarget(const VibratorAllInfos &device, const VibratorIdentifierIPC &identifier)
+{
+    VibratorTarget target;
+    target.identifier = identifier;
+    target.thread = device.controlInfo.GetVibratorThread(identifier.vibratorId);
+    target.waveInfo = device.waveInfo;
+    target.playbackMutex = device.playbackMutex;
+    return target;
+}
 }  // namespace
 
 std::atomic_int32_t MiscdeviceService::timeModeCallTimes_ = 0;
@@ -93,8 +113,8 @@ std::mutex MiscdeviceService::invalidVibratorInfoMutex_;
 std::mutex MiscdeviceService::stopMutex_;
 bool MiscdeviceService::isVibrationPriorityReady_ = false;
 std::map<int32_t, VibratorAllInfos> MiscdeviceService::devicesManageMap_;
-std::mutex MiscdeviceService::devicesManageMutex_;
-std::map<sptr<IRemoteObject>, int32_t> MiscdeviceService::clientPidMap_;
+std::shared_mutex MiscdeviceService::devicesManageMutex_;
+std::unordered_map<sptr<IRemoteObject>, int32_t, RemoteObjectHash> MiscdeviceService::clientPidMap_;
 std::mutex MiscdeviceService::clientPidMapMutex_;
 std::atomic_bool MiscdeviceService::deviceMute_ = false;
 
@@ -102,7 +122,8 @@ MiscdeviceService::MiscdeviceService()
     : SystemAbility(MISCDEVICE_SERVICE_ABILITY_ID, true),
       lightExist_(false),
       vibratorExist_(false),
-      state_(MiscdeviceServiceState::STATE_STOPPED)
+      state_(MiscdeviceServiceState::STATE_STOPPED),
+      packageNameCache_(PACKAGE_NAME_CACHE_CAPACITY)
 {
     MISC_HILOGD("Add SystemAbility");
 }
@@ -161,6 +182,11 @@ void MiscdeviceService::OnAddSystemAbility(int32_t systemAbilityId, const std::s
             if (ret != ERR_OK) {
                 MISC_HILOGE("Subscribe usual.event.DATA_SHARE_READY fail");
             }
+            ret = SubscribeCommonEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED,
+                [this](const EventFwk::CommonEventData &data) { this->OnReceivePackageRemovedEvent(data); });
+            if (ret != ERR_OK) {
+                MISC_HILOGE("Subscribe usual.event.PACKAGE_REMOVED fail");
+            }
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
             ret = SubscribeCommonEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_SWITCHED,
                 [this](const EventFwk::CommonEventData &data) { this->OnReceiveUserSwitchEvent(data); });
@@ -216,6 +242,24 @@ void MiscdeviceService::OnReceiveEvent(const EventFwk::CommonEventData &data)
     }
 }
 
+void MiscdeviceService::OnReceivePackageRemovedEvent(const EventFwk::CommonEventData &data)
+{
+    const auto &want = data.GetWant();
+    if (want.GetAction() != EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) {
+        return;
+    }
+    /** The token of an uninstalled hap may be handed out again, so its cached name must go with it */
+    int32_t tokenId = want.GetIntParam(ACCESS_TOKEN_ID, 0);
+    if (tokenId == 0) {
+        MISC_HILOGW("Package removed without token, clear package name cache");
+        packageNameCache_.Clear();
+        PermissionUtil::GetInstance().ClearVerdicts();
+        return;
+    }
+    packageNameCache_.Erase(static_cast<uint32_t>(tokenId));
+    PermissionUtil::GetInstance().EraseVerdict(static_cast<AccessTokenID>(tokenId));
+}
+
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
 void MiscdeviceService::OnReceiveUserSwitchEvent(const EventFwk::CommonEventData &data)
 {
@@ -262,9 +306,28 @@ void MiscdeviceService::OnStart()
 #endif // MEMMGR_ENABLE
     AddSystemAbilityListener(COMMON_EVENT_SERVICE_ID);
     RegisterVibratorPlugCb();
+    LoadRateConfigs();
     reportCallTimesThread_ = std::thread([this]() { this->ReportCallTimes(); });
 }
 
+void MiscdeviceService::LoadRateConfigs()
+{
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        std::string suffix = std::to_string(usage);
+        VibrateRateConfig config;
+        config.ratePerSecond = OHOS::system::GetUintParameter<uint32_t>(RATE_LIMIT_PARAM + suffix, 0,
+            MAX_RATE_LIMIT);
+        if (config.ratePerSecond == 0) {
+            continue;
+        }
+        config.burst = OHOS::system::GetUintParameter<uint32_t>(RATE_BURST_PARAM + suffix, config.ratePerSecond,
+            MAX_RATE_LIMIT);
+        RateLimiter.SetRateConfig(usage, config);
+        MISC_HILOGI("Rate limit of usage %{public}d, rate:%{public}u, burst:%{public}u", usage,
+            config.ratePerSecond, config.burst);
+    }
+}
+
 int32_t MiscdeviceService::RegisterVibratorPlugCb()
 {
     auto ret = vibratorHdiConnection_.RegisterVibratorPlugCallback(
@@ -363,6 +426,8 @@ void MiscdeviceService::OnStop()
         return;
     }
     state_ = MiscdeviceServiceState::STATE_STOPPED;
+    HdiExecutorPool.Shutdown();
+    PlugDispatcher.Shutdown();
     int32_t ret = vibratorHdiConnection_.DestroyHdiConnection();
     if (ret != ERR_OK) {
         MISC_HILOGE("Destroy hdi connection fail");
@@ -373,7 +438,7 @@ void MiscdeviceService::OnStop()
 #endif // MEMMGR_ENABLE
 }
 
-bool MiscdeviceService::ShouldIgnoreVibrate(const VibrateInfo &info, const VibratorIdentifierIPC& identifier)
+bool MiscdeviceService::ShouldIgnoreVibrate(const VibrateInfo &info, const VibratorTarget &target)
 {
     std::lock_guard<std::mutex> lock(isVibrationPriorityReadyMutex_);
     if (!isVibrationPriorityReady_) {
@@ -383,15 +448,24 @@ bool MiscdeviceService::ShouldIgnoreVibrate(const VibrateInfo &info, const Vibra
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
     std::call_once(isRegistered_, [this]() { RegisterDeviceMuteObserver(); });
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    std::string curVibrateTime = GetCurrentTime();
-    auto vibratorThread_ = GetVibratorThread(identifier);
-    int32_t ret = PriorityManager->ShouldIgnoreVibrate(info, vibratorThread_, identifier);
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    int32_t ret = PriorityManager->ShouldIgnoreVibrate(info, target.thread, target.identifier);
     if (ret != VIBRATION) {
-        MISC_HILOGE("ShouldIgnoreVibrate currentTime:%{public}s, ret:%{public}d", curVibrateTime.c_str(), ret);
+        MISC_HILOGE("ShouldIgnoreVibrate currentTime:%{public}" PRId64 ", ret:%{public}d", curVibrateTime, ret);
     }
     return (ret != VIBRATION);
 }
 
+bool MiscdeviceService::IsVibrateAdmitted(int32_t usage)
+{
+    int32_t pid = GetCallingPid();
+    if (RateLimiter.TryAcquire(pid, GetCallingUid(), usage)) {
+        return true;
+    }
+    MISC_HILOGD("Vibrate request is rate limited, pid:%{public}d, usage:%{public}d", pid, usage);
+    return false;
+}
+
 int32_t MiscdeviceService::Vibrate(const VibratorIdentifierIPC& identifier, int32_t timeOut, int32_t usage,
     bool systemUsage)
 {
@@ -411,6 +485,9 @@ int32_t MiscdeviceService::Vibrate(const VibratorIdentifierIPC& identifier, int3
         MISC_HILOGE("Invalid parameter");
         return PARAMETER_ERROR;
     }
+    if (!IsVibrateAdmitted(usage)) {
+        return ERROR;
+    }
     VibrateInfo info = {
         .mode = VIBRATE_TIME,
         .packageName = GetPackageName(GetCallingTokenID()),
@@ -420,15 +497,17 @@ int32_t MiscdeviceService::Vibrate(const VibratorIdentifierIPC& identifier, int3
         .systemUsage = systemUsage,
         .duration = timeOut
     };
-    std::string curVibrateTime = GetCurrentTime();
-    if (StartVibrateThreadControl(identifier, info) != ERR_OK) {
-        MISC_HILOGE("%{public}s:vibration is ignored and high priority is vibrating or no vibration found",
-            curVibrateTime.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(std::move(info));
+    if (StartVibrateThreadControl(identifier, playback) != ERR_OK) {
+        MISC_HILOGE("%{public}" PRId64 ":vibration is ignored and high priority is vibrating or no vibration found",
+            curVibrateTime);
         return ERROR;
     }
-    MISC_HILOGW("Start vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, usage:%{public}d,"
-        "deviceId:%{public}d, vibratorId:%{public}d, duration:%{public}d", curVibrateTime.c_str(),
-        info.packageName.c_str(), info.pid, info.usage, identifier.deviceId, identifier.vibratorId, info.duration);
+    MISC_HILOGW("Start vibrator, currentTime:%{public}" PRId64 ", package:%{public}s, pid:%{public}d, usage:%{public}d,"
+        "deviceId:%{public}d, vibratorId:%{public}d, duration:%{public}d", curVibrateTime,
+        playback->packageName.c_str(), playback->pid, playback->usage, identifier.deviceId, identifier.vibratorId,
+        playback->duration);
     return NO_ERROR;
 }
 
@@ -444,51 +523,68 @@ int32_t MiscdeviceService::StopVibrator(const VibratorIdentifierIPC& identifier)
         MISC_HILOGE("Result:%{public}d", ret);
         return PERMISSION_DENIED;
     }
-    std::lock_guard<std::mutex> lock(devicesManageMutex_);
     return StopVibratorService(identifier);
 }
 
 int32_t MiscdeviceService::StopVibratorService(const VibratorIdentifierIPC& identifier)
 {
-    std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-    std::vector<VibratorIdentifierIPC> result = CheckDeviceIdIsValid(identifier);
-    size_t ignoreVibrateNum = 0;
+    std::vector<VibratorTarget> result = ResolveVibratorTargets(identifier);
     if (result.empty()) {
         MISC_HILOGD("result is empty, no need to stop");
         return ERROR;
     }
-    for (const auto& paramIt : result) {
-        auto vibratorThread_ = GetVibratorThread(paramIt);
+    if (StopVibratorTargets(result) == 0) {
+        MISC_HILOGD("No vibration, no need to stop");
+        return NO_ERROR;
+    }
+    std::string packageName = GetPackageName(GetCallingTokenID());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    MISC_HILOGW("Stop vibrator, currentTime:%{public}" PRId64 ", package:%{public}s,"
+        " pid:%{public}d, deviceId:%{public}d,"
+        "vibratorId:%{public}d", curVibrateTime, packageName.c_str(), GetCallingPid(), identifier.deviceId,
+        identifier.vibratorId);
+    return NO_ERROR;
+}
+
+size_t MiscdeviceService::StopVibratorTargets(const std::vector<VibratorTarget> &targets)
+{
+    auto playbackLocks = LockPlayback(targets);
+    size_t stopVibrateNum = 0;
+    for (const auto& target : targets) {
+        const VibratorIdentifierIPC &paramIt = target.identifier;
+        auto vibratorThread_ = target.thread;
+        Coalescer.Reset(paramIt);
+        bool owned = OwnerIndex.Unbind(paramIt);
+        if (vibratorThread_ == nullptr) {
+            MISC_HILOGD("Thread is not running, no need to stop");
+            continue;
+        }
+        /** The worker is stopped first, so it cannot re-arm the motor after the HDI stop below */
+        bool threadPlaying = vibratorThread_->IsPlaying();
+        StopVibrateThread(vibratorThread_);
         #if defined (OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM)
-            if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning() &&
-                !vibratorHdiConnection_.IsVibratorRunning(paramIt))) {
+            int32_t ret = StopOnHdiLane(paramIt, [this, paramIt]() {
+                if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
+                    vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_PRESET);
+                    vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_HDHAPTIC);
+                }
+            });
+            if (ret != ERR_OK) {
+                MISC_HILOGE("Stop vibrator fail, vibratorId:%{public}d", paramIt.vibratorId);
+            }
+            if (!threadPlaying && !owned) {
                 MISC_HILOGD("Thread is not running, no need to stop");
-                ignoreVibrateNum ++;
                 continue;
             }
-            if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
-                vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_PRESET);
-                vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_HDHAPTIC);
-            }
         #else
-            if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning())) {
+            if (!threadPlaying) {
                 MISC_HILOGD("Thread is not running, no need to stop");
-                ignoreVibrateNum ++;
                 continue;
             }
         #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-            StopVibrateThread(vibratorThread_);
+            ++stopVibrateNum;
     }
-    if (ignoreVibrateNum == result.size()) {
-        MISC_HILOGD("No vibration, no need to stop");
-        return NO_ERROR;
-    }
-    std::string packageName = GetPackageName(GetCallingTokenID());
-    std::string curVibrateTime = GetCurrentTime();
-    MISC_HILOGW("Stop vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, deviceId:%{public}d,"
-        "vibratorId:%{public}d", curVibrateTime.c_str(), packageName.c_str(), GetCallingPid(), identifier.deviceId,
-        identifier.vibratorId);
-    return NO_ERROR;
+    return stopVibrateNum;
 }
 
 int32_t MiscdeviceService::PlayVibratorEffect(const VibratorIdentifierIPC& identifier, const std::string &effect,
@@ -501,7 +597,7 @@ int32_t MiscdeviceService::PlayVibratorEffect(const VibratorIdentifierIPC& ident
         return checkResult;
     }
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(identifier, effect);
+    std::optional<HdfEffectInfo> effectInfo = GetCachedEffectInfo(identifier, effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
@@ -525,16 +621,17 @@ int32_t MiscdeviceService::PlayVibratorEffect(const VibratorIdentifierIPC& ident
         .count = count,
         .intensity = INTENSITY_ADJUST_MAX
     };
-    std::string curVibrateTime = GetCurrentTime();
-    if (StartVibrateThreadControl(identifier, info) != ERR_OK) {
-        MISC_HILOGE("%{public}s:vibration is ignored and high priority is vibrating or no vibration found",
-            curVibrateTime.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(std::move(info));
+    if (StartVibrateThreadControl(identifier, playback) != ERR_OK) {
+        MISC_HILOGE("%{public}" PRId64 ":vibration is ignored and high priority is vibrating or no vibration found",
+            curVibrateTime);
         return ERROR;
     }
-    MISC_HILOGW("Start vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, usage:%{public}d,"
+    MISC_HILOGW("Start vibrator, currentTime:%{public}" PRId64 ", package:%{public}s, pid:%{public}d, usage:%{public}d,"
         "deviceId:%{public}d, vibratorId:%{public}d, duration:%{public}d, effect:%{public}s, count:%{public}d",
-        curVibrateTime.c_str(), info.packageName.c_str(), info.pid, info.usage, identifier.deviceId,
-        identifier.vibratorId, info.duration, info.effect.c_str(), info.count);
+        curVibrateTime, playback->packageName.c_str(), playback->pid, playback->usage, identifier.deviceId,
+        identifier.vibratorId, playback->duration, playback->effect.c_str(), playback->count);
     return NO_ERROR;
 }
 
@@ -554,38 +651,35 @@ int32_t MiscdeviceService::PlayVibratorEffectCheckAuthAndParam(int32_t count, in
         MISC_HILOGE("Invalid parameter");
         return PARAMETER_ERROR;
     }
+    if (!IsVibrateAdmitted(usage)) {
+        return ERROR;
+    }
     return ERR_OK;
 }
 
-void MiscdeviceService::StartVibrateThread(VibrateInfo info, const VibratorIdentifierIPC& identifier)
+void MiscdeviceService::StartVibrateThread(const VibrateInfoPtr &info, const VibratorTarget &target,
+    const std::shared_ptr<PlaybackGroup> &group)
 {
-    auto vibratorThread_ = GetVibratorThread(identifier);
+    auto vibratorThread_ = target.thread;
     if (vibratorThread_ == nullptr) {
         MISC_HILOGD("No effective vibrator thread");
         return;
     }
-    std::vector<HdfWaveInformation> waveInfo;
-    if (GetAllWaveInfo(identifier, waveInfo) != ERR_OK) {
-        MISC_HILOGE("GetAllWaveInfo failed");
-        return;
-    }
+    const VibratorIdentifierIPC &identifier = target.identifier;
+    WaveInfosPtr waveInfo = (target.waveInfo != nullptr) ? target.waveInfo : EMPTY_WAVE_INFOS;
+    Coalescer.Record(identifier, *info);
+    OwnerIndex.Bind(info->pid, identifier, info->sessionId);
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
-    VibrateInfo currentVibrateInfo = vibratorThread_->GetCurrentVibrateInfo();
-    if (info.duration <= SHORT_VIBRATOR_DURATION && currentVibrateInfo.duration <= SHORT_VIBRATOR_DURATION &&
-        info.mode == VIBRATE_PRESET && currentVibrateInfo.mode == VIBRATE_PRESET && info.count == 1) {
+    VibrateInfoPtr currentVibrateInfo = vibratorThread_->GetCurrentVibrateInfo();
+    if (group == nullptr && info->duration <= SHORT_VIBRATOR_DURATION &&
+        currentVibrateInfo->duration <= SHORT_VIBRATOR_DURATION && info->mode == VIBRATE_PRESET &&
+        currentVibrateInfo->mode == VIBRATE_PRESET && info->count == 1) {
         vibratorThread_->UpdateVibratorEffect(info, identifier, waveInfo);
-        FastVibratorEffect(info, identifier);
+        FastVibratorEffect(*info, identifier);
     } else {
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
-    StopVibrateThread(vibratorThread_);
-#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    if (vibratorHdiConnection_.IsVibratorRunning(identifier)) {
-        vibratorHdiConnection_.Stop(identifier, HDF_VIBRATOR_MODE_PRESET);
-        vibratorHdiConnection_.Stop(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
-    }
-#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    vibratorThread_->UpdateVibratorEffect(info, identifier, waveInfo);
-    vibratorThread_->Start("VibratorThread");
+    StopPreviousPlayback(target);
+    vibratorThread_->Play(info, identifier, waveInfo, group);
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
     }
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
@@ -594,15 +688,29 @@ void MiscdeviceService::StartVibrateThread(VibrateInfo info, const VibratorIdent
 
 void MiscdeviceService::StopVibrateThread(std::shared_ptr<VibratorThread> vibratorThread)
 {
-    if ((vibratorThread != nullptr) && (vibratorThread->IsRunning())) {
-        vibratorThread->NotifyExit();
-        vibratorThread->NotifyExitSync();
-        vibratorThread->SetExitStatus(false);
-        vibratorThread->ResetVibrateInfo();
+    if ((vibratorThread != nullptr) && (vibratorThread->IsPlaying())) {
+        vibratorThread->Stop();
     }
 }
 
-int32_t MiscdeviceService::StopVibratorByMode(const VibratorIdentifierIPC& identifier, const std::string &mode)
+void MiscdeviceService::StopPreviousPlayback(const VibratorTarget &target)
+{
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    /** Queued ahead of the new playback's HDI calls, a preempted worker leaves the motor stop to this one */
+    const VibratorIdentifierIPC &identifier = target.identifier;
+    int32_t ret = StopOnHdiLane(identifier, [this, identifier]() {
+        if (vibratorHdiConnection_.IsVibratorRunning(identifier)) {
+            vibratorHdiConnection_.Stop(identifier, HDF_VIBRATOR_MODE_PRESET);
+            vibratorHdiConnection_.Stop(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
+        }
+    });
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Stop previous playback fail, vibratorId:%{public}d", identifier.vibratorId);
+    }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+}
+
+int32_t MiscdeviceService::StopVibratorByMode(const VibratorIdentifierIPC& identifier, int32_t mode)
 {
     PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
     int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
@@ -614,30 +722,49 @@ int32_t MiscdeviceService::StopVibratorByMode(const VibratorIdentifierIPC& ident
         MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
         return PERMISSION_DENIED;
     }
-    std::lock_guard<std::mutex> devicesManageLock(devicesManageMutex_);
-    std::vector<VibratorIdentifierIPC> result = CheckDeviceIdIsValid(identifier);
+    if ((mode <= VIBRATE_BUTT) || (mode >= VIBRATE_MODE_MAX)) {
+        MISC_HILOGE("Invalid mode:%{public}d", mode);
+        return PARAMETER_ERROR;
+    }
+    std::vector<VibratorTarget> result = ResolveVibratorTargets(identifier);
     size_t ignoreVibrateNum = 0;
     if (result.empty()) {
         MISC_HILOGD("result is empty, no need to stop");
         return ERROR;
     }
-    std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-    for (const auto& paramIt : result) {
-        auto vibratorThread_ = GetVibratorThread(paramIt);
-        if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning() &&
-            !vibratorHdiConnection_.IsVibratorRunning(paramIt))) {
+    auto playbackLocks = LockPlayback(result);
+    for (const auto& target : result) {
+        const VibratorIdentifierIPC &paramIt = target.identifier;
+        auto vibratorThread_ = target.thread;
+        bool hdiRunning = false;
+        if ((vibratorThread_ != nullptr) && !vibratorThread_->IsPlaying()) {
+            int32_t queryRet = RunOnHdiLane(paramIt, [this, &paramIt, &hdiRunning]() {
+                hdiRunning = vibratorHdiConnection_.IsVibratorRunning(paramIt);
+            });
+            if (queryRet != ERR_OK) {
+                return ERROR;
+            }
+        }
+        if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsPlaying() && !hdiRunning)) {
             MISC_HILOGD("Thread is not running, no need to stop");
             ignoreVibrateNum ++;
             continue;
         }
-        const VibrateInfo info = vibratorThread_->GetCurrentVibrateInfo();
-        if (info.mode != mode) {
+        VibrateInfoPtr info = vibratorThread_->GetCurrentVibrateInfo();
+        if (info->mode != mode) {
             MISC_HILOGD("Stop vibration information mismatch");
             continue;
         }
+        Coalescer.Reset(paramIt);
+        OwnerIndex.Unbind(paramIt);
         StopVibrateThread(vibratorThread_);
-        if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
-            vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_PRESET);
+        int32_t stopRet = StopOnHdiLane(paramIt, [this, paramIt]() {
+            if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
+                vibratorHdiConnection_.Stop(paramIt, HDF_VIBRATOR_MODE_PRESET);
+            }
+        });
+        if (stopRet != ERR_OK) {
+            return ERROR;
         }
     }
     if (ignoreVibrateNum == result.size()) {
@@ -645,10 +772,11 @@ int32_t MiscdeviceService::StopVibratorByMode(const VibratorIdentifierIPC& ident
         return NO_ERROR;
     }
     std::string packageName = GetPackageName(GetCallingTokenID());
-    std::string curVibrateTime = GetCurrentTime();
-    MISC_HILOGW("Stop vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, deviceId:%{public}d,"
-        "vibratorId:%{public}d, mode:%{public}s", curVibrateTime.c_str(), packageName.c_str(), GetCallingPid(),
-        identifier.deviceId, identifier.vibratorId, mode.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    MISC_HILOGW("Stop vibrator, currentTime:%{public}" PRId64 ", package:%{public}s,"
+        " pid:%{public}d, deviceId:%{public}d,"
+        "vibratorId:%{public}d, mode:%{public}s", curVibrateTime, packageName.c_str(), GetCallingPid(),
+        identifier.deviceId, identifier.vibratorId, GetVibrateModeName(mode).c_str());
     return NO_ERROR;
 }
 
@@ -656,36 +784,27 @@ int32_t MiscdeviceService::IsSupportEffect(const VibratorIdentifierIPC& identifi
     bool &state)
 {
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(identifier, effect);
+    std::optional<HdfEffectInfo> effectInfo = GetCachedEffectInfo(identifier, effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
     }
     state = effectInfo->isSupportEffect;
     std::string packageName = GetPackageName(GetCallingTokenID());
-    std::string curVibrateTime = GetCurrentTime();
-    MISC_HILOGI("IsSupportEffect, currentTime:%{public}s, package:%{public}s, pid:%{public}d, effect:%{public}s,"
-        "state:%{public}d", curVibrateTime.c_str(), packageName.c_str(), GetCallingPid(), effect.c_str(), state);
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    MISC_HILOGI("IsSupportEffect, currentTime:%{public}" PRId64 ", package:%{public}s,"
+        " pid:%{public}d, effect:%{public}s,"
+        "state:%{public}d", curVibrateTime, packageName.c_str(), GetCallingPid(), effect.c_str(), state);
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     return NO_ERROR;
 }
 
-std::string MiscdeviceService::GetCurrentTime()
+int64_t MiscdeviceService::GetCurrentTimeMs()
 {
     timespec curTime;
     clock_gettime(CLOCK_REALTIME, &curTime);
-    struct tm *timeinfo = localtime(&(curTime.tv_sec));
-    std::string currentTime;
-    if (timeinfo == nullptr) {
-        MISC_HILOGE("timeinfo is null");
-        return currentTime;
-    }
-    currentTime.append(std::to_string(timeinfo->tm_year + BASE_YEAR)).append("-")
-        .append(std::to_string(timeinfo->tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo->tm_mday))
-        .append(" ").append(std::to_string(timeinfo->tm_hour)).append(":").append(std::to_string(timeinfo->tm_min))
-        .append(":").append(std::to_string(timeinfo->tm_sec)).append(".")
-        .append(std::to_string(curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE)));
-    return currentTime;
+    return static_cast<int64_t>(curTime.tv_sec) * CONVERSION_RATE +
+        curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE);
 }
 
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
@@ -752,15 +871,16 @@ int32_t MiscdeviceService::PlayVibratorCustom(const VibratorIdentifierIPC& ident
     } else if (capacity.isSupportTimeDelay) {
         info.mode = VIBRATE_CUSTOM_COMPOSITE_TIME;
     }
-    std::string curVibrateTime = GetCurrentTime();
-    if (StartVibrateThreadControl(identifier, info) != ERR_OK) {
-        MISC_HILOGE("%{public}s:vibration is ignored and high priority is vibrating or no vibration found",
-            curVibrateTime.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(std::move(info));
+    if (StartVibrateThreadControl(identifier, playback) != ERR_OK) {
+        MISC_HILOGE("%{public}" PRId64 ":vibration is ignored and high priority is vibrating or no vibration found",
+            curVibrateTime);
         return ERROR;
     }
-    MISC_HILOGW("Start vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, usage:%{public}d,"
-        "vibratorId:%{public}d, duration:%{public}d", curVibrateTime.c_str(), info.packageName.c_str(), info.pid,
-        info.usage, identifier.vibratorId, pkg.packageDuration);
+    MISC_HILOGW("Start vibrator, currentTime:%{public}" PRId64 ", package:%{public}s, pid:%{public}d, usage:%{public}d,"
+        "vibratorId:%{public}d, duration:%{public}d", curVibrateTime, playback->packageName.c_str(), playback->pid,
+        playback->usage, identifier.vibratorId, pkg.packageDuration);
     return NO_ERROR;
 }
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
@@ -791,10 +911,26 @@ int32_t MiscdeviceService::CheckAuthAndParam(int32_t usage, const VibrateParamet
         MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
         return PARAMETER_ERROR;
     }
+    if (!IsVibrateAdmitted(usage)) {
+        return ERROR;
+    }
     return ERR_OK;
 }
 
 std::string MiscdeviceService::GetPackageName(AccessTokenID tokenId)
+{
+    std::string packageName;
+    if (packageNameCache_.Find(tokenId, packageName)) {
+        return packageName;
+    }
+    packageName = QueryPackageName(tokenId);
+    if (!packageName.empty()) {
+        packageNameCache_.Insert(tokenId, packageName);
+    }
+    return packageName;
+}
+
+std::string MiscdeviceService::QueryPackageName(AccessTokenID tokenId)
 {
     std::string packageName;
     int32_t tokenType = AccessTokenKit::GetTokenTypeFlag(tokenId);
@@ -835,6 +971,9 @@ int32_t MiscdeviceService::GetLightList(std::vector<LightInfoIPC> &lightInfoIpcL
     if (ret != ERR_OK) {
         MISC_HILOGE("GetLightList failed, ret:%{public}d", ret);
     }
+    for (const auto &item : lightInfos_) {
+        HdiExecutorPool.Add(HDI_DOMAIN_LIGHT, item.GetLightId());
+    }
     size_t lightCount = lightInfos_.size();
     MISC_HILOGI("lightCount:%{public}zu", lightCount);
     if (lightCount > MAX_LIGHT_COUNT) {
@@ -870,12 +1009,13 @@ int32_t MiscdeviceService::TurnOn(int32_t lightId, int32_t singleColor, const Li
         MISC_HILOGE("animation is invalid");
         return MISCDEVICE_NATIVE_SAM_ERR;
     }
-    ret = lightHdiConnection_.TurnOn(lightId, color, animation);
-    if (ret != ERR_OK) {
-        MISC_HILOGE("TurnOn failed, error:%{public}d", ret);
-        return ERROR;
-    }
-    return ret;
+    bool posted = HdiExecutorPool.Post(HDI_DOMAIN_LIGHT, lightId, [this, lightId, color, animation]() {
+        int32_t result = lightHdiConnection_.TurnOn(lightId, color, animation);
+        if (result != ERR_OK) {
+            MISC_HILOGE("TurnOn failed, error:%{public}d", result);
+        }
+    });
+    return posted ? ERR_OK : ERROR;
 }
 
 int32_t MiscdeviceService::TurnOff(int32_t lightId)
@@ -896,12 +1036,13 @@ int32_t MiscdeviceService::TurnOff(int32_t lightId)
         MISC_HILOGE("lightId is invalid, lightId:%{public}d", lightId);
         return MISCDEVICE_NATIVE_SAM_ERR;
     }
-    ret = lightHdiConnection_.TurnOff(lightId);
-    if (ret != ERR_OK) {
-        MISC_HILOGE("TurnOff failed, error:%{public}d", ret);
-        return ERROR;
-    }
-    return ret;
+    bool posted = HdiExecutorPool.Post(HDI_DOMAIN_LIGHT, lightId, [this, lightId]() {
+        int32_t result = lightHdiConnection_.TurnOff(lightId);
+        if (result != ERR_OK) {
+            MISC_HILOGE("TurnOff failed, error:%{public}d", result);
+        }
+    });
+    return posted ? ERR_OK : ERROR;
 }
 
 int32_t MiscdeviceService::Dump(int32_t fd, const std::vector<std::u16string> &args)
@@ -927,16 +1068,18 @@ int32_t MiscdeviceService::Dump(int32_t fd, const std::vector<std::u16string> &a
 }
 
 int32_t MiscdeviceService::PerformVibrationControl(const VibratorIdentifierIPC& identifier,
-    int32_t duration, VibrateInfo& info)
+    int32_t duration, VibrateInfo &&info)
 {
-    std::string curVibrateTime = GetCurrentTime();
-    if (StartVibrateThreadControl(identifier, info) != ERR_OK) {
-        MISC_HILOGE("%{public}s:vibration is ignored and high priority is vibrating or no vibration found",
-            curVibrateTime.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(std::move(info));
+    if (StartVibrateThreadControl(identifier, playback) != ERR_OK) {
+        MISC_HILOGE("%{public}" PRId64 ":vibration is ignored and high priority is vibrating or no vibration found",
+            curVibrateTime);
         return ERROR;
     }
-    MISC_HILOGW("Start vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, usage:%{public}d,"
-        "duration:%{public}d", curVibrateTime.c_str(), info.packageName.c_str(), info.pid, info.usage, duration);
+    MISC_HILOGW("Start vibrator, currentTime:%{public}" PRId64 ", package:%{public}s, pid:%{public}d, usage:%{public}d,"
+        "duration:%{public}d", curVibrateTime, playback->packageName.c_str(), playback->pid, playback->usage,
+        duration);
     return ERR_OK;
 }
 
@@ -1045,22 +1188,27 @@ int32_t MiscdeviceService::PlayPattern(const VibratorIdentifierIPC& identifier,
         return ERROR;
     }
     if (capacity.isSupportHdHaptic) {
-        int32_t result = PerformVibrationControl(identifier, pattern.patternDuration, info);
+        int32_t result = PerformVibrationControl(identifier, pattern.patternDuration, std::move(info));
         if (result != ERR_OK) {
             MISC_HILOGE("PerformVibrationControl failed");
             return result;
         }
-        if (sessionId > 0) {
-            return vibratorHdiConnection_.PlayPatternBySessionId(identifier, sessionId, package.patterns.front());
-        }
-        return vibratorHdiConnection_.PlayPattern(identifier, package.patterns.front());
+        VibratePattern hdPattern = package.patterns.front();
+        return PostToHdiLane(identifier, [this, identifier, sessionId, hdPattern]() {
+            int32_t ret = (sessionId > 0) ?
+                vibratorHdiConnection_.PlayPatternBySessionId(identifier, sessionId, hdPattern) :
+                vibratorHdiConnection_.PlayPattern(identifier, hdPattern);
+            if (ret != ERR_OK) {
+                MISC_HILOGE("PlayPattern failed, ret:%{public}d, sessionId:%{public}u", ret, sessionId);
+            }
+        });
     } else if (capacity.isSupportPresetMapping) {
         info.mode = VIBRATE_CUSTOM_COMPOSITE_EFFECT;
     } else if (capacity.isSupportTimeDelay) {
         info.mode = VIBRATE_CUSTOM_COMPOSITE_TIME;
     }
-    info.package = package;
-    return PerformVibrationControl(identifier, pattern.patternDuration, info);
+    info.package = std::move(package);
+    return PerformVibrationControl(identifier, pattern.patternDuration, std::move(info));
 }
 
 int32_t MiscdeviceService::PlayPackageBySessionId(const VibratorIdentifierIPC &identifier,
@@ -1088,20 +1236,25 @@ int32_t MiscdeviceService::PlayPackageBySessionId(const VibratorIdentifierIPC &i
         return ERROR;
     }
     if (capacity.isSupportHdHaptic) {
-        int32_t result = PerformVibrationControl(identifier, package.packageDuration, info);
+        int32_t result = PerformVibrationControl(identifier, package.packageDuration, std::move(info));
         if (result != ERR_OK) {
             MISC_HILOGE("PerformVibrationControl failed");
             return result;
         }
         uint32_t sessionId = customHapticInfoIPC.parameter.sessionId;
-        return vibratorHdiConnection_.PlayPackageBySessionId(identifier, sessionId, package);
+        return PostToHdiLane(identifier, [this, identifier, sessionId, package]() {
+            int32_t ret = vibratorHdiConnection_.PlayPackageBySessionId(identifier, sessionId, package);
+            if (ret != ERR_OK) {
+                MISC_HILOGE("PlayPackageBySessionId failed, ret:%{public}d, sessionId:%{public}u", ret, sessionId);
+            }
+        });
     } else if (capacity.isSupportPresetMapping) {
         info.mode = VIBRATE_CUSTOM_COMPOSITE_EFFECT;
     } else if (capacity.isSupportTimeDelay) {
         info.mode = VIBRATE_CUSTOM_COMPOSITE_TIME;
     }
     info.packageIPC = package;
-    return PerformVibrationControl(identifier, package.packageDuration, info);
+    return PerformVibrationControl(identifier, package.packageDuration, std::move(info));
 }
 
 int32_t MiscdeviceService::StopVibrateBySessionId(const VibratorIdentifierIPC &identifier, uint32_t sessionId)
@@ -1117,22 +1270,26 @@ int32_t MiscdeviceService::StopVibrateBySessionId(const VibratorIdentifierIPC &i
         MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
         return PERMISSION_DENIED;
     }
-    std::lock_guard<std::mutex> lock(devicesManageMutex_);
-    std::vector<VibratorIdentifierIPC> result = CheckDeviceIdIsValid(identifier);
+    std::vector<VibratorTarget> result = ResolveVibratorTargets(identifier);
     size_t ignoreVibrateNum = 0;
     if (result.empty()) {
         MISC_HILOGE("result is empty, no need to stop");
         return ERROR;
     }
-    for (const auto& paramIt : result) {
-        auto vibratorThread_ = GetVibratorThread(paramIt);
-        if (!vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
+    auto playbackLocks = LockPlayback(result);
+    for (const auto& target : result) {
+        const VibratorIdentifierIPC &paramIt = target.identifier;
+        int32_t stopRet = StopOnHdiLane(paramIt, [this, paramIt, sessionId]() {
+            if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
+                vibratorHdiConnection_.StopVibrateBySessionId(paramIt, sessionId);
+            }
+        });
+        if (stopRet != ERR_OK) {
+            return ERROR;
+        }
+        if (!OwnerIndex.UnbindSession(paramIt, sessionId)) {
             MISC_HILOGD("Thread is not running, no need to stop");
             ignoreVibrateNum++;
-            continue;
-        }
-        if (vibratorHdiConnection_.IsVibratorRunning(paramIt)) {
-            vibratorHdiConnection_.StopVibrateBySessionId(paramIt, sessionId);
         }
     }
     if (ignoreVibrateNum == result.size()) {
@@ -1140,9 +1297,10 @@ int32_t MiscdeviceService::StopVibrateBySessionId(const VibratorIdentifierIPC &i
         return NO_ERROR;
     }
     std::string packageName = GetPackageName(GetCallingTokenID());
-    std::string curVibrateTime = GetCurrentTime();
-    MISC_HILOGW("Stop vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, deviceId:%{public}d,"
-        "vibratorId:%{public}d, sessionId:%{public}d", curVibrateTime.c_str(), packageName.c_str(), GetCallingPid(),
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    MISC_HILOGW("Stop vibrator, currentTime:%{public}" PRId64 ", package:%{public}s,"
+        " pid:%{public}d, deviceId:%{public}d,"
+        "vibratorId:%{public}d, sessionId:%{public}d", curVibrateTime, packageName.c_str(), GetCallingPid(),
         identifier.deviceId, identifier.vibratorId, sessionId);
     return NO_ERROR;
 }
@@ -1163,6 +1321,9 @@ int32_t MiscdeviceService::PlayPatternCheckAuthAndParam(int32_t usage, const Vib
         MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
         return PARAMETER_ERROR;
     }
+    if (!IsVibrateAdmitted(usage)) {
+        return ERROR;
+    }
     return ERR_OK;
 }
 
@@ -1175,7 +1336,16 @@ int32_t MiscdeviceService::GetDelayTime(const VibratorIdentifierIPC& identifier,
         MISC_HILOGE("GetVibratorCapacity failed");
         return ERROR;
     }
-    return vibratorHdiConnection_.GetDelayTime(identifier, capacity.GetVibrateMode(), delayTime);
+    if (GetCachedStartUpTime(identifier, capacity.GetVibrateMode(), delayTime)) {
+        return NO_ERROR;
+    }
+    int32_t ret = ERROR;
+    if (RunOnHdiLane(identifier, [this, &identifier, &capacity, &delayTime, &ret]() {
+        ret = vibratorHdiConnection_.GetDelayTime(identifier, capacity.GetVibrateMode(), delayTime);
+    }) != ERR_OK) {
+        return ERROR;
+    }
+    return ret;
 }
 
 bool MiscdeviceService::CheckVibratorParmeters(const VibrateParameter &parameter)
@@ -1220,43 +1390,112 @@ void MiscdeviceService::SendMsgToClient(const HdfVibratorPlugInfo &info)
 {
     MISC_HILOGI("Device:%{public}d state change, state:%{public}d, deviceName:%{public}s", info.deviceId, info.status,
         info.deviceName.c_str());
-    std::lock_guard<std::mutex> lockManage(devicesManageMutex_);
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    EffectCatalog.Erase(info.deviceId);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     if (info.status == 0) {
-        auto it = devicesManageMap_.find(info.deviceId);
-        if (it != devicesManageMap_.end()) {
-            VibratorIdentifierIPC identifier;
-            for (auto &value : it->second.baseInfo) {
-                identifier.deviceId = info.deviceId;
-                identifier.vibratorId = value.vibratorId;
-                StopVibratorService(identifier);
+        std::vector<VibratorTarget> targets;
+        {
+            std::unique_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+            auto it = devicesManageMap_.find(info.deviceId);
+            if (it != devicesManageMap_.end()) {
+                VibratorIdentifierIPC identifier;
+                for (auto &value : it->second.baseInfo) {
+                    identifier.deviceId = info.deviceId;
+                    identifier.vibratorId = value.vibratorId;
+                    targets.push_back(BuildVibratorTarget(it->second, identifier));
+                }
+                devicesManageMap_.erase(it);
+                MISC_HILOGI("Device %{public}d is offline and removed from the map.", info.deviceId);
             }
-            devicesManageMap_.erase(it);
-            MISC_HILOGI("Device %{public}d is offline and removed from the map.", info.deviceId);
+            std::lock_guard<std::mutex> probeLock(probeMutex_);
+            vibratorProbes_.erase(info.deviceId);
         }
+        (void)StopVibratorTargets(targets);
+        HdiExecutorPool.Remove(HDI_DOMAIN_VIBRATOR, info.deviceId);
+        PlugDispatcher.Publish(info.status, info.deviceId, info.vibratorCnt);
     } else {
-        std::vector<HdfVibratorInfo> vibratorInfo;
-        auto ret = vibratorHdiConnection_.GetVibratorInfo(vibratorInfo);
-        if (ret != NO_ERROR || vibratorInfo.empty()) {
-            MISC_HILOGE("Device not contain the local vibrator");
+        /** Online is published by the probe once the device is usable */
+        StartVibratorProbe(info);
+    }
+}
+
+void MiscdeviceService::StartVibratorProbe(const HdfVibratorPlugInfo &info)
+{
+    auto probe = std::make_shared<std::promise<void>>();
+    {
+        std::lock_guard<std::mutex> probeLock(probeMutex_);
+        vibratorProbes_[info.deviceId] = VibratorProbe { probe, probe->get_future().share() };
+    }
+    VibratorIdentifierIPC identifier;
+    identifier.deviceId = info.deviceId;
+    HdiExecutorPool.Add(HDI_DOMAIN_VIBRATOR, info.deviceId);
+    if (PostToHdiLane(identifier, [this, info, probe]() { ProbeVibratorDevice(info, probe); }) != ERR_OK) {
+        MISC_HILOGE("Probe vibrator of device %{public}d fail", info.deviceId);
+        {
+            std::lock_guard<std::mutex> probeLock(probeMutex_);
+            auto it = vibratorProbes_.find(info.deviceId);
+            if ((it != vibratorProbes_.end()) && (it->second.promise == probe)) {
+                vibratorProbes_.erase(it);
+            }
         }
-        if (InsertVibratorInfo(info.deviceId, info.deviceName, vibratorInfo) != NO_ERROR) {
-            MISC_HILOGE("Insert vibrator of device %{public}d fail", info.deviceId);
+        probe->set_value();
+    }
+}
+
+void MiscdeviceService::ProbeVibratorDevice(const HdfVibratorPlugInfo &info,
+    const std::shared_ptr<std::promise<void>> &probe)
+{
+    std::vector<HdfVibratorInfo> vibratorInfo;
+    auto ret = vibratorHdiConnection_.GetVibratorInfo(vibratorInfo);
+    if (ret != NO_ERROR || vibratorInfo.empty()) {
+        MISC_HILOGE("Device not contain the local vibrator");
+    }
+    bool inserted = (InsertVibratorInfo(info.deviceId, info.deviceName, vibratorInfo, probe) == NO_ERROR);
+    if (!inserted) {
+        MISC_HILOGE("Insert vibrator of device %{public}d fail", info.deviceId);
+    }
+    {
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        std::lock_guard<std::mutex> probeLock(probeMutex_);
+        auto it = vibratorProbes_.find(info.deviceId);
+        if ((it != vibratorProbes_.end()) && (it->second.promise == probe)) {
+            vibratorProbes_.erase(it);
+            /** Published under the locks the offline path takes first, so its offline event always comes after */
+            if (inserted && (devicesManageMap_.find(info.deviceId) != devicesManageMap_.end())) {
+                PlugDispatcher.Publish(info.status, info.deviceId, info.vibratorCnt);
+            }
         }
     }
+    probe->set_value();
+}
 
-    std::lock_guard<std::mutex> lock(clientPidMapMutex_);
-    MISC_HILOGI("Device:%{public}d state change,state:%{public}d, clientPidMap_.size::%{public}zu",
-        info.deviceId, info.status, clientPidMap_.size());
-    for (auto it = clientPidMap_.begin(); it != clientPidMap_.end(); ++it) {
-        const sptr<IRemoteObject>& key = it->first;
+bool MiscdeviceService::IsCurrentProbe(int32_t deviceId, const std::shared_ptr<std::promise<void>> &probe)
+{
+    std::lock_guard<std::mutex> probeLock(probeMutex_);
+    auto it = vibratorProbes_.find(deviceId);
+    return (it != vibratorProbes_.end()) && (it->second.promise == probe);
+}
 
-        sptr<IVibratorClient> clientProxy = iface_cast<IVibratorClient>(key);
-        if (clientProxy != nullptr) {
-            MISC_HILOGI("Device:%{public}d state change,state:%{public}d, ProcessPlugEvent",
-                        info.deviceId, info.status);
-            clientProxy->ProcessPlugEvent(info.status, info.deviceId, info.vibratorCnt);
+bool MiscdeviceService::WaitVibratorProbe(int32_t deviceId)
+{
+    std::vector<std::pair<int32_t, std::shared_future<void>>> pending;
+    {
+        std::lock_guard<std::mutex> probeLock(probeMutex_);
+        for (const auto &[probeDeviceId, probe] : vibratorProbes_) {
+            if ((deviceId == -1) || (probeDeviceId == deviceId)) {
+                pending.emplace_back(probeDeviceId, probe.done);
+            }
         }
     }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(PROBE_WAIT_TIMEOUT);
+    for (const auto &[probeDeviceId, done] : pending) {
+        if (done.wait_until(deadline) != std::future_status::ready) {
+            MISC_HILOGW("Device %{public}d is still probing", probeDeviceId);
+            return false;
+        }
+    }
+    return true;
 }
 
 int32_t MiscdeviceService::TransferClientRemoteObject(const sptr<IRemoteObject> &vibratorServiceClient)
@@ -1275,32 +1514,27 @@ void MiscdeviceService::ProcessDeathObserver(const wptr<IRemoteObject> &object)
     CALL_LOG_ENTER;
     sptr<IRemoteObject> client = object.promote();
     int32_t clientPid = FindClientPid(client);
-    VibrateInfo info;
-    std::lock_guard<std::mutex> lock(devicesManageMutex_);
-    for (const auto& pair : devicesManageMap_) {
-        int deviceId = pair.first;
-        const VibratorControlInfo& vibratorControlInfo_ = pair.second.controlInfo;
-        MISC_HILOGI("Device ID:%{public}d, , Motor Count:%{public}d", deviceId, vibratorControlInfo_.motorCount);
-        for (const auto& motorPair : vibratorControlInfo_.vibratorThreads) {
-            int motorId = motorPair.first;
-            {
-                std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-                auto vibratorThread_ = motorPair.second;
-                if (vibratorThread_ == nullptr) {
-                    MISC_HILOGE("MotorId:%{public}d, Vibrate thread no found in devicesManageMap_", motorId);
-                    vibratorThread_ = std::make_shared<VibratorThread>();
+    if (clientPid != INVALID_PID) {
+        std::vector<OwnedVibration> ownedVibrations = OwnerIndex.Release(clientPid);
+        MISC_HILOGI("ClientPid:%{public}d, owned motors:%{public}zu", clientPid, ownedVibrations.size());
+        /** Every start rebinds its motors, so the index alone tells what is still playing for the pid */
+        for (const auto& vibration : ownedVibrations) {
+            const VibratorIdentifierIPC &identifier = vibration.identifier;
+            if (vibration.sessionId > 0) {
+                int32_t ret = StopOnHdiLane(identifier, [this, vibration]() {
+                    vibratorHdiConnection_.StopVibrateBySessionId(vibration.identifier, vibration.sessionId);
+                });
+                if (ret != ERR_OK) {
+                    MISC_HILOGE("Stop session %{public}u fail", vibration.sessionId);
                 }
-                info = vibratorThread_->GetCurrentVibrateInfo();
-            }
-            int32_t vibratePid = info.pid;
-            MISC_HILOGI("ClientPid:%{public}d, VibratePid:%{public}d", clientPid, vibratePid);
-            if ((clientPid != INVALID_PID) && (clientPid == vibratePid)) {
-                VibratorIdentifierIPC identifier;
-                identifier.deviceId = deviceId;
-                identifier.vibratorId = motorId;
-                StopVibratorService(identifier);
             }
+            (void)StopVibratorTargets(ResolveVibratorTargets(identifier));
         }
+        {
+            std::lock_guard<std::mutex> guard(pidMutex_);
+            disablePids_.erase(clientPid);
+        }
+        RateLimiter.Erase(clientPid);
     }
     UnregisterClientDeathRecipient(client);
 }
@@ -1350,7 +1584,20 @@ void MiscdeviceService::SaveClientPid(const sptr<IRemoteObject> &vibratorService
         MISC_HILOGE("The maximum number of supported clients has been exceeded");
         return;
     }
-    clientPidMap_.insert(std::make_pair(vibratorServiceClient, pid));
+    if (!clientPidMap_.insert(std::make_pair(vibratorServiceClient, pid)).second) {
+        return;
+    }
+    sptr<IVibratorClient> clientProxy = iface_cast<IVibratorClient>(vibratorServiceClient);
+    if (clientProxy == nullptr) {
+        MISC_HILOGE("ClientProxy is nullptr");
+        return;
+    }
+    PlugDispatcher.Subscribe(reinterpret_cast<uintptr_t>(vibratorServiceClient.GetRefPtr()),
+        [clientProxy](const VibratorPlugEvent &event) {
+            MISC_HILOGI("Device:%{public}d state change,state:%{public}d, ProcessPlugEvent",
+                event.deviceId, event.status);
+            clientProxy->ProcessPlugEvent(event.status, event.deviceId, event.vibratorCnt);
+        });
 }
 
 int32_t MiscdeviceService::FindClientPid(const sptr<IRemoteObject> &vibratorServiceClient)
@@ -1381,6 +1628,7 @@ void MiscdeviceService::DestroyClientPid(const sptr<IRemoteObject> &vibratorServ
         return;
     }
     clientPidMap_.erase(it);
+    PlugDispatcher.Unsubscribe(reinterpret_cast<uintptr_t>(vibratorServiceClient.GetRefPtr()));
 }
 
 int32_t MiscdeviceService::PlayPrimitiveEffect(const VibratorIdentifierIPC& identifier,
@@ -1393,7 +1641,7 @@ int32_t MiscdeviceService::PlayPrimitiveEffect(const VibratorIdentifierIPC& iden
         return checkResult;
     }
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-    std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(identifier, effect);
+    std::optional<HdfEffectInfo> effectInfo = GetCachedEffectInfo(identifier, effect);
     if (!effectInfo) {
         MISC_HILOGE("GetEffectInfo fail");
         return ERROR;
@@ -1417,16 +1665,17 @@ int32_t MiscdeviceService::PlayPrimitiveEffect(const VibratorIdentifierIPC& iden
         .count = primitiveEffectIPC.count,
         .intensity = primitiveEffectIPC.intensity
     };
-    std::string curVibrateTime = GetCurrentTime();
-    if (StartVibrateThreadControl(identifier, info) != ERR_OK) {
-        MISC_HILOGE("%{public}s:vibration is ignored and high priority is vibrating or no vibration found",
-            curVibrateTime.c_str());
+    int64_t curVibrateTime = GetCurrentTimeMs();
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(std::move(info));
+    if (StartVibrateThreadControl(identifier, playback) != ERR_OK) {
+        MISC_HILOGE("%{public}" PRId64 ":vibration is ignored and high priority is vibrating or no vibration found",
+            curVibrateTime);
         return ERROR;
     }
-    MISC_HILOGW("Start vibrator, currentTime:%{public}s, package:%{public}s, pid:%{public}d, usage:%{public}d,"
+    MISC_HILOGW("Start vibrator, currentTime:%{public}" PRId64 ", package:%{public}s, pid:%{public}d, usage:%{public}d,"
         "deviceId:%{public}d, vibratorId:%{public}d, duration:%{public}d, effect:%{public}s, intensity:%{public}d",
-        curVibrateTime.c_str(), info.packageName.c_str(), info.pid, info.usage, identifier.deviceId,
-        identifier.vibratorId, info.duration, info.effect.c_str(), info.intensity);
+        curVibrateTime, playback->packageName.c_str(), playback->pid, playback->usage, identifier.deviceId,
+        identifier.vibratorId, playback->duration, playback->effect.c_str(), playback->intensity);
     return NO_ERROR;
 }
 
@@ -1446,6 +1695,46 @@ int32_t MiscdeviceService::PlayPrimitiveEffectCheckAuthAndParam(int32_t intensit
         MISC_HILOGE("Invalid parameter");
         return PARAMETER_ERROR;
     }
+    if (!IsVibrateAdmitted(usage)) {
+        return ERROR;
+    }
+    return ERR_OK;
+}
+
+int32_t MiscdeviceService::GetHdiLaneId(const VibratorIdentifierIPC &identifier)
+{
+    int32_t deviceId = identifier.deviceId;
+    if (deviceId == -1) {
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        (void)GetLocalDeviceId(deviceId);
+    }
+    return deviceId;
+}
+
+int32_t MiscdeviceService::PostToHdiLane(const VibratorIdentifierIPC &identifier, std::function<void()> task)
+{
+    if (!HdiExecutorPool.Post(HDI_DOMAIN_VIBRATOR, GetHdiLaneId(identifier), std::move(task))) {
+        MISC_HILOGE("HDI queue of device %{public}d rejected the call", identifier.deviceId);
+        return ERROR;
+    }
+    return ERR_OK;
+}
+
+int32_t MiscdeviceService::StopOnHdiLane(const VibratorIdentifierIPC &identifier, std::function<void()> task)
+{
+    if (!HdiExecutorPool.Post(HDI_DOMAIN_VIBRATOR, GetHdiLaneId(identifier), std::move(task), true)) {
+        MISC_HILOGE("HDI queue of device %{public}d rejected the stop", identifier.deviceId);
+        return ERROR;
+    }
+    return ERR_OK;
+}
+
+int32_t MiscdeviceService::RunOnHdiLane(const VibratorIdentifierIPC &identifier, const std::function<void()> &task)
+{
+    if (!HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, GetHdiLaneId(identifier), task)) {
+        MISC_HILOGE("HDI queue of device %{public}d rejected the call", identifier.deviceId);
+        return ERROR;
+    }
     return ERR_OK;
 }
 
@@ -1491,7 +1780,10 @@ int32_t MiscdeviceService::GetVibratorList(const VibratorIdentifierIPC& identifi
     CALL_LOG_ENTER;
     identifier.Dump();
     GetOnlineVibratorInfo();
-    std::lock_guard<std::mutex> lockManage(devicesManageMutex_);
+    if (identifier.deviceId != -1) {
+        (void)WaitVibratorProbe(identifier.deviceId);
+    }
+    std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
     if ((identifier.deviceId == -1) && (identifier.vibratorId == -1)) {
         for (auto &value : devicesManageMap_) {
             vibratorInfoIPC.insert(vibratorInfoIPC.end(), value.second.baseInfo.begin(),
@@ -1529,32 +1821,63 @@ int32_t MiscdeviceService::GetEffectInfo(const VibratorIdentifierIPC& identifier
 {
     CALL_LOG_ENTER;
     identifier.Dump();
-    std::lock_guard<std::mutex> devicesManageLock(devicesManageMutex_);
-    if (devicesManageMap_.empty()) {
-        MISC_HILOGI("No vibrator device online");
-        return NO_ERROR;
-    }
     VibratorIdentifierIPC localIdentifier;
-    if (identifier.deviceId == -1) {
-        for (const auto& pair : devicesManageMap_) {
-            for (const auto& info : pair.second.baseInfo) {
-                info.isLocalVibrator ? (localIdentifier.deviceId = info.deviceId) : 0;
+    {
+        std::shared_lock<std::shared_mutex> devicesManageLock(devicesManageMutex_);
+        if (devicesManageMap_.empty()) {
+            MISC_HILOGI("No vibrator device online");
+            return NO_ERROR;
+        }
+        if (identifier.deviceId == -1) {
+            for (const auto& pair : devicesManageMap_) {
+                for (const auto& info : pair.second.baseInfo) {
+                    info.isLocalVibrator ? (localIdentifier.deviceId = info.deviceId) : 0;
+                }
             }
         }
     }
-    HdfEffectInfo hdfEffectInfo;
-    int32_t ret = vibratorHdiConnection_.GetEffectInfo((identifier.deviceId == -1) ? localIdentifier : identifier,
-        effectType, hdfEffectInfo);
-    if (ret != NO_ERROR) {
+    std::optional<HdfEffectInfo> hdfEffectInfo =
+        GetCachedEffectInfo((identifier.deviceId == -1) ? localIdentifier : identifier, effectType);
+    if (!hdfEffectInfo) {
         MISC_HILOGE("HDI::GetEffectInfo return error");
         return ERROR;
     }
-    effectInfoIPC.duration = hdfEffectInfo.duration;
-    effectInfoIPC.isSupportEffect = hdfEffectInfo.isSupportEffect;
+    effectInfoIPC.duration = hdfEffectInfo->duration;
+    effectInfoIPC.isSupportEffect = hdfEffectInfo->isSupportEffect;
     effectInfoIPC.Dump();
     return NO_ERROR;
 }
 
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+std::optional<HdfEffectInfo> MiscdeviceService::GetCachedEffectInfo(const VibratorIdentifierIPC& identifier,
+    const std::string &effect)
+{
+    std::optional<HdfEffectInfo> effectInfo = std::nullopt;
+    auto queryEffectInfo = [this, &identifier, &effect, &effectInfo]() {
+        effectInfo = vibratorHdiConnection_.GetEffectInfo(identifier, effect);
+    };
+    int32_t deviceId = identifier.deviceId;
+    if (deviceId == -1) {
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        if (GetLocalDeviceId(deviceId) != NO_ERROR) {
+            MISC_HILOGE("Local vibrator not found");
+            return std::nullopt;
+        }
+    }
+    effectInfo = EffectCatalog.Find(deviceId, effect);
+    if (effectInfo) {
+        return effectInfo;
+    }
+    if (RunOnHdiLane(identifier, queryEffectInfo) != ERR_OK) {
+        return std::nullopt;
+    }
+    if (effectInfo) {
+        EffectCatalog.Insert(deviceId, effect, *effectInfo);
+    }
+    return effectInfo;
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
 int32_t MiscdeviceService::SubscribeVibratorPlugInfo(const sptr<IRemoteObject> &vibratorServiceClient)
 {
     auto clientPid = GetCallingPid();
@@ -1586,36 +1909,71 @@ int32_t MiscdeviceService::GetVibratorCapacity(const VibratorIdentifierIPC& iden
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
 int32_t MiscdeviceService::FastVibratorEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier)
 {
-    int32_t ret = VibratorDevice.StartByIntensity(identifier, info.effect, info.intensity);
-    if (ret != SUCCESS) {
+    int32_t ret = ERROR;
+    if (RunOnHdiLane(identifier, [&info, &identifier, &ret]() {
+        ret = VibratorDevice.StartByIntensity(identifier, info.effect, info.intensity);
+    }) != ERR_OK || ret != SUCCESS) {
         MISC_HILOGE("Vibrate effect %{public}s failed.", info.effect.c_str());
     }
     return NO_ERROR;
 }
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_PRESET_INFO
 
-std::shared_ptr<VibratorThread> MiscdeviceService::GetVibratorThread(const VibratorIdentifierIPC& identifier)
+std::vector<VibratorTarget> MiscdeviceService::ResolveVibratorTargets(const VibratorIdentifierIPC& identifier)
 {
     CALL_LOG_ENTER;
-    auto deviceIt = devicesManageMap_.find(identifier.deviceId);
-    if (deviceIt != devicesManageMap_.end()) {
-        auto thread = deviceIt->second.controlInfo.GetVibratorThread(identifier.vibratorId);
-        if (thread) {
-            MISC_HILOGI("Success: Vibrate thread found.");
-            return thread;
-        } else {
+    bool waitProbe = (identifier.deviceId != -1);
+    if (!waitProbe) {
+        /** Local targets only wait while no local device is known, the one being probed may then be it */
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        int32_t localDeviceId = -1;
+        waitProbe = (GetLocalDeviceId(localDeviceId) != NO_ERROR);
+    }
+    if (waitProbe && !WaitVibratorProbe(identifier.deviceId)) {
+        return {};
+    }
+    std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+    std::vector<VibratorTarget> targets;
+    for (const auto& paramIt : CheckDeviceIdIsValid(identifier)) {
+        auto deviceIt = devicesManageMap_.find(paramIt.deviceId);
+        if (deviceIt == devicesManageMap_.end()) {
+            continue;
+        }
+        VibratorTarget target = BuildVibratorTarget(deviceIt->second, paramIt);
+        if (target.thread == nullptr) {
             MISC_HILOGE("Failed: Vibrate thread no found.");
-            return nullptr;
         }
+        targets.push_back(std::move(target));
     }
-    return nullptr;
+    return targets;
+}
+
+std::vector<std::unique_lock<std::mutex>> MiscdeviceService::LockPlayback(const std::vector<VibratorTarget> &targets)
+{
+    /** Device locks are always taken in address order, so requests spanning several devices cannot deadlock */
+    std::vector<std::mutex *> playbackMutexes;
+    for (const auto& target : targets) {
+        if (target.playbackMutex != nullptr) {
+            playbackMutexes.push_back(target.playbackMutex.get());
+        }
+    }
+    std::sort(playbackMutexes.begin(), playbackMutexes.end(), std::less<std::mutex *>());
+    playbackMutexes.erase(std::unique(playbackMutexes.begin(), playbackMutexes.end()), playbackMutexes.end());
+    std::vector<std::unique_lock<std::mutex>> playbackLocks;
+    for (auto playbackMutex : playbackMutexes) {
+        playbackLocks.emplace_back(*playbackMutex);
+    }
+    return playbackLocks;
 }
 
 int32_t MiscdeviceService::GetHapticCapacityInfo(const VibratorIdentifierIPC& identifier,
     VibratorCapacity& capacityInfo)
 {
     CALL_LOG_ENTER;
-    std::lock_guard<std::mutex> lock(devicesManageMutex_);
+    if (identifier.deviceId != -1) {
+        (void)WaitVibratorProbe(identifier.deviceId);
+    }
+    std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
     if (identifier.deviceId != -1) {
         auto deviceIt = devicesManageMap_.find(identifier.deviceId);
         if (deviceIt != devicesManageMap_.end()) {
@@ -1637,10 +1995,13 @@ int32_t MiscdeviceService::GetHapticCapacityInfo(const VibratorIdentifierIPC& id
     return ERR_OK;
 }
 
-int32_t MiscdeviceService::GetAllWaveInfo(const VibratorIdentifierIPC& identifier,
-    std::vector<HdfWaveInformation>& waveInfo)
+int32_t MiscdeviceService::GetAllWaveInfo(const VibratorIdentifierIPC& identifier, WaveInfosPtr& waveInfo)
 {
     CALL_LOG_ENTER;
+    if (identifier.deviceId != -1) {
+        (void)WaitVibratorProbe(identifier.deviceId);
+    }
+    std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
     if (identifier.deviceId != -1) {
         auto deviceIt = devicesManageMap_.find(identifier.deviceId);
         if (deviceIt != devicesManageMap_.end()) {
@@ -1674,6 +2035,44 @@ int32_t MiscdeviceService::GetHapticStartUpTime(const VibratorIdentifierIPC& ide
     return NO_ERROR;
 }
 
+std::map<int32_t, int32_t> MiscdeviceService::QueryStartUpTimes(const VibratorIdentifierIPC& identifier,
+    const VibratorCapacity &capacity)
+{
+    /** Only modes the actuator reports are queried, so unsupported ones raise no HDI fault */
+    std::vector<int32_t> modes;
+    capacity.isSupportHdHaptic ? modes.push_back(VIBRATE_MODE_HD) : (void)0;
+    capacity.isSupportPresetMapping ? modes.push_back(VIBRATE_MODE_MAPPING) : (void)0;
+    capacity.isSupportTimeDelay ? modes.push_back(VIBRATE_MODE_TIMES) : (void)0;
+    std::map<int32_t, int32_t> startUpTimes;
+    for (int32_t mode : modes) {
+        int32_t startUpTime = 0;
+        if (GetHapticStartUpTime(identifier, mode, startUpTime) == NO_ERROR) {
+            startUpTimes[mode] = startUpTime;
+        }
+    }
+    return startUpTimes;
+}
+
+bool MiscdeviceService::GetCachedStartUpTime(const VibratorIdentifierIPC& identifier, int32_t mode,
+    int32_t &startUpTime)
+{
+    std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+    int32_t deviceId = identifier.deviceId;
+    if ((deviceId == -1) && (GetLocalDeviceId(deviceId) != NO_ERROR)) {
+        return false;
+    }
+    auto deviceIt = devicesManageMap_.find(deviceId);
+    if (deviceIt == devicesManageMap_.end()) {
+        return false;
+    }
+    auto it = deviceIt->second.startUpTimes.find(mode);
+    if (it == deviceIt->second.startUpTimes.end()) {
+        return false;
+    }
+    startUpTime = it->second;
+    return true;
+}
+
 void MiscdeviceService::ConvertToServerInfos(const std::vector<HdfVibratorInfo> &baseVibratorInfo,
     const VibratorCapacity &vibratorCapacity, const std::vector<HdfWaveInformation> &waveInfomation,
     const HdfVibratorPlugInfo &info, VibratorAllInfos& vibratorAllInfos)
@@ -1692,16 +2091,21 @@ void MiscdeviceService::ConvertToServerInfos(const std::vector<HdfVibratorInfo>
             vibratorInfo.isLocalVibrator);
     }
     vibratorAllInfos.capacityInfo = vibratorCapacity;
-    vibratorAllInfos.waveInfo = waveInfomation;
+    vibratorAllInfos.waveInfo = std::make_shared<const std::vector<HdfWaveInformation>>(waveInfomation);
 }
 
 void MiscdeviceService::GetOnlineVibratorInfo()
 {
     CALL_LOG_ENTER;
-    std::lock_guard<std::mutex> lockManage(devicesManageMutex_);
-    if (!devicesManageMap_.empty()) {
-        MISC_HILOGD("devicesManageMap_ not empty");
-        return;
+    {
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        if (!devicesManageMap_.empty()) {
+            MISC_HILOGD("devicesManageMap_ not empty");
+            for (const auto &[deviceId, infos] : devicesManageMap_) {
+                HdiExecutorPool.Add(HDI_DOMAIN_VIBRATOR, deviceId);
+            }
+            return;
+        }
     }
     std::vector<HdfVibratorInfo> vibratorInfo;
     auto ret = vibratorHdiConnection_.GetVibratorInfo(vibratorInfo);
@@ -1711,29 +2115,40 @@ void MiscdeviceService::GetOnlineVibratorInfo()
     }
 
     const std::string deviceName = "";
+    std::set<int32_t> insertedDevices;
     for (auto &info : vibratorInfo) {
-        const auto it = devicesManageMap_.find(info.deviceId);
-        if (it != devicesManageMap_.end()) {
+        if (!insertedDevices.insert(info.deviceId).second) {
             continue;
         }
-        if (InsertVibratorInfo(info.deviceId, deviceName, vibratorInfo) != NO_ERROR) {
+        HdiExecutorPool.Add(HDI_DOMAIN_VIBRATOR, info.deviceId);
+        int32_t ret = NO_ERROR;
+        bool executed = HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, info.deviceId,
+            [this, &info, &deviceName, &vibratorInfo, &ret]() {
+                ret = InsertVibratorInfo(info.deviceId, deviceName, vibratorInfo);
+            });
+        if (!executed || (ret != NO_ERROR)) {
             MISC_HILOGW("Insert vibrator of device %{public}d fail", info.deviceId);
         }
     }
 }
 
 int32_t MiscdeviceService::InsertVibratorInfo(int deviceId, const std::string &deviceName,
-    const std::vector<HdfVibratorInfo> &vibratorInfo)
+    const std::vector<HdfVibratorInfo> &vibratorInfo, const std::shared_ptr<std::promise<void>> &probe)
 {
     CALL_LOG_ENTER;
+    {
+        std::shared_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+        if (devicesManageMap_.find(deviceId) != devicesManageMap_.end()) {
+            MISC_HILOGW("The deviceId already exists in devicesManageMap_, deviceId: %{public}d", deviceId);
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+            EffectCatalog.AddDevice(deviceId);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+            return NO_ERROR;
+        }
+    }
     std::vector<HdfVibratorInfo> infos;
     std::vector<int> vibratorIdList;
     for (auto &info : vibratorInfo) {
-        const auto it = devicesManageMap_.find(info.deviceId);
-        if (it != devicesManageMap_.end()) {
-            MISC_HILOGW("The deviceId already exists in devicesManageMap_, deviceId: %{public}d", info.deviceId);
-            continue;
-        }
         if (info.deviceId == deviceId) {
             infos.emplace_back(info);
             vibratorIdList.push_back(info.vibratorId);
@@ -1752,9 +2167,9 @@ int32_t MiscdeviceService::InsertVibratorInfo(int deviceId, const std::string &d
     if (ret != NO_ERROR) {
         MISC_HILOGW("Get capacity fail from HDI, then use the default capacity, deviceId: %{public}d", param.deviceId);
     }
+    std::map<int32_t, int32_t> startUpTimes = QueryStartUpTimes(param, capacity);
     std::vector<HdfWaveInformation> waveInfo;
-    ret = vibratorHdiConnection_.GetAllWaveInfo(param, waveInfo);
-    if (ret != NO_ERROR) {
+    if (vibratorHdiConnection_.GetAllWaveInfo(param, waveInfo) != NO_ERROR) {
         MISC_HILOGW("Get waveInfo fail from HDI, deviceId: %{public}d", param.deviceId);
     }
 
@@ -1762,64 +2177,111 @@ int32_t MiscdeviceService::InsertVibratorInfo(int deviceId, const std::string &d
     mockInfo.deviceName = deviceName;
     VibratorAllInfos localVibratorInfo(vibratorIdList);
     (void)ConvertToServerInfos(infos, capacity, waveInfo, mockInfo, localVibratorInfo);
-    devicesManageMap_.insert(std::make_pair(param.deviceId, localVibratorInfo));
+    localVibratorInfo.startUpTimes = startUpTimes;
+    for (const auto& [motorId, vibratorThread] : localVibratorInfo.controlInfo.vibratorThreads) {
+        if (vibratorThread != nullptr) {
+            vibratorThread->SetStartUpTimes(startUpTimes);
+        }
+    }
+    /** The HDI was queried without the table lock, only the insertion itself is exclusive */
+    std::unique_lock<std::shared_mutex> lockManage(devicesManageMutex_);
+    if ((probe != nullptr) && !IsCurrentProbe(deviceId, probe)) {
+        MISC_HILOGW("Device %{public}d went offline while probing", deviceId);
+        return NO_ERROR;
+    }
+    if (!devicesManageMap_.insert(std::make_pair(param.deviceId, localVibratorInfo)).second) {
+        MISC_HILOGW("The deviceId already exists in devicesManageMap_, deviceId: %{public}d", param.deviceId);
+    }
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    EffectCatalog.AddDevice(param.deviceId);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     return NO_ERROR;
 }
 
-int32_t MiscdeviceService::StartVibrateThreadControl(const VibratorIdentifierIPC& identifier, VibrateInfo& info)
+int32_t MiscdeviceService::StartVibrateThreadControl(const VibratorIdentifierIPC& identifier,
+    const VibrateInfoPtr &playback)
 {
-    std::lock_guard<std::mutex> lockManage(devicesManageMutex_);
-    std::string curVibrateTime = GetCurrentTime();
-    std::vector<VibratorIdentifierIPC> result = CheckDeviceIdIsValid(identifier);
+    std::vector<VibratorTarget> result = ResolveVibratorTargets(identifier);
     if (result.empty()) {
         MISC_HILOGE("No vibration found");
         return ERROR;
     }
     {
         std::lock_guard<std::mutex> guard(pidMutex_);
-        if (std::find(disablePids_.begin(), disablePids_.end(), info.pid) != disablePids_.end()) {
-            MISC_HILOGE("Pid :%{public}d is disabled, reject vibration", info.pid);
+        if (disablePids_.count(playback->pid) != 0) {
+            MISC_HILOGE("Pid :%{public}d is disabled, reject vibration", playback->pid);
             return ERROR;
         }
     }
     size_t ignoreVibrateNum = 0;
-
-    const std::vector<std::string> specialModes = {
-        VIBRATE_CUSTOM_HD, VIBRATE_CUSTOM_COMPOSITE_EFFECT,
-        VIBRATE_CUSTOM_COMPOSITE_TIME, VIBRATE_BUTT
-    };
-
     std::unordered_set<int32_t> uniqueIndices;
-    if (std::find(specialModes.begin(), specialModes.end(), info.mode) != specialModes.end()) {
-        for (const auto& pattern : info.package.patterns) {
+    if ((playback->mode != VIBRATE_TIME) && (playback->mode != VIBRATE_PRESET)) {
+        for (const auto& pattern : playback->package.patterns) {
             for (const auto& event : pattern.events) {
                 uniqueIndices.insert(event.index);
             }
         }
         for (const auto& index : uniqueIndices) {
-            MISC_HILOGD("Info mode:%{public}s, vibratorIndex:%{public}d", info.mode.c_str(), index);
+            MISC_HILOGD("Info mode:%{public}s, vibratorIndex:%{public}d",
+                GetVibrateModeName(playback->mode).c_str(), index);
         }
     }
-    std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-    for (const auto& paramIt : result) {
+    auto playbackLocks = LockPlayback(result);
+    std::vector<VibratorTarget> targets;
+    for (const auto& target : result) {
+        const VibratorIdentifierIPC &paramIt = target.identifier;
         bool shouldProcess = uniqueIndices.empty() ||
         uniqueIndices.find(0) != uniqueIndices.end() ||
         uniqueIndices.find(paramIt.position) != uniqueIndices.end();
 
-        if (paramIt.isLocalVibrator && ShouldIgnoreVibrate(info, paramIt)) {
+        if (shouldProcess && Coalescer.TryMerge(paramIt, *playback)) {
+            MISC_HILOGD("Merged into the playing effect, vibratorId:%{public}d", paramIt.vibratorId);
+            continue;
+        }
+        if (paramIt.isLocalVibrator && ShouldIgnoreVibrate(*playback, target)) {
             if (shouldProcess) {
                 ignoreVibrateNum++;
                 continue;
             }
         }
         if (shouldProcess) {
-            StartVibrateThread(info, paramIt);
+            targets.push_back(target);
         }
     }
-
+    StartVibrateGroup(playback, targets);
     return (ignoreVibrateNum == result.size()) ? ERROR : ERR_OK;
 }
 
+void MiscdeviceService::StartVibrateGroup(const VibrateInfoPtr &info, const std::vector<VibratorTarget> &targets)
+{
+    if (targets.empty()) {
+        return;
+    }
+    if (targets.size() == 1) {
+        StartVibrateThread(info, targets.front());
+        return;
+    }
+    /** Every motor is armed first and released together, so the lead only has to cover arming the workers */
+    auto group = CreatePlaybackGroup(targets);
+    if (info->mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT) {
+        for (const auto& target : targets) {
+            group->AddPartition(target.identifier.position,
+                VibratorThread::copyPackageWithIndexEvents(info->package, target.identifier));
+        }
+    }
+    for (const auto& target : targets) {
+        StartVibrateThread(info, target, group);
+    }
+}
+
+std::shared_ptr<PlaybackGroup> MiscdeviceService::CreatePlaybackGroup(const std::vector<VibratorTarget> &targets)
+{
+    /** The workers wait on their own clock, so the shared start time has to be read from it as well */
+    const std::shared_ptr<VibratorThread> &thread = targets.front().thread;
+    VibratorClock::TimePoint now = (thread != nullptr) ? thread->Now() : VibratorClock::GetSteadyClock()->Now();
+    return std::make_shared<PlaybackGroup>(now + std::chrono::milliseconds(GROUP_START_LEAD_TIME), targets.size());
+}
+
 bool MiscdeviceService::IsVibratorIdValid(const std::vector<VibratorInfoIPC> baseInfo, int32_t target)
 {
     for (const auto& item : baseInfo) {
@@ -1828,8 +2290,7 @@ bool MiscdeviceService::IsVibratorIdValid(const std::vector<VibratorInfoIPC> bas
         }
     }
     std::string packageName = GetPackageName(GetCallingTokenID());
-    invalidVibratorIdCount_++;
-    if (invalidVibratorIdCount_ == LOG_COUNT_FIVE) {
+    if (++invalidVibratorIdCount_ == LOG_COUNT_FIVE) {
         invalidVibratorIdCount_ = 0;
         MISC_HILOGE("VibratorId is not valid. package:%{public}s vibratorid:%{public}d", packageName.c_str(), target);
     }
@@ -1910,9 +2371,7 @@ int32_t MiscdeviceService::DisableVibratorByPid(int32_t pid)
     }
     MISC_HILOGD("Disable pid: %{public}d", pid);
     std::lock_guard<std::mutex> guard(pidMutex_);
-    auto it = std::find(disablePids_.begin(), disablePids_.end(), pid);
-    if (it == disablePids_.end()) {
-        disablePids_.push_back(pid);
+    if (disablePids_.insert(pid).second) {
         MISC_HILOGD("Pid %{public}d added to disabled list", pid);
     }
     return ERR_OK;
@@ -1936,12 +2395,131 @@ int32_t MiscdeviceService::EnableVibratorByPid(int32_t pid)
     }
     MISC_HILOGD("Disable pid: %{public}d", pid);
     std::lock_guard<std::mutex> guard(pidMutex_);
-    auto it = std::find(disablePids_.begin(), disablePids_.end(), pid);
-    if (it != disablePids_.end()) {
-        disablePids_.erase(it);
+    if (disablePids_.erase(pid) != 0) {
         MISC_HILOGD("Pid %{public}d removed from disabled list", pid);
     }
     return ERR_OK;
 }
+
+int32_t MiscdeviceService::PlayVibratorBatch(const VibrateBatchIPC &batch)
+{
+    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
+    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    if (ret != PERMISSION_GRANTED) {
+#ifdef HIVIEWDFX_HISYSEVENT_ENABLE
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
+            HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayVibratorBatchStub", "ERROR_CODE", ret);
+#endif // HIVIEWDFX_HISYSEVENT_ENABLE
+        MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
+        return PERMISSION_DENIED;
+    }
+    if (batch.items.empty() || (batch.items.size() > static_cast<size_t>(MAX_VIBRATE_BATCH_SIZE)) ||
+        (batch.usage >= USAGE_MAX) || (batch.usage < 0)) {
+        MISC_HILOGE("Invalid parameter, items:%{public}zu, usage:%{public}d", batch.items.size(), batch.usage);
+        return PARAMETER_ERROR;
+    }
+    VibrateInfo common = {
+        .packageName = GetPackageName(GetCallingTokenID()),
+        .pid = GetCallingPid(),
+        .uid = GetCallingUid(),
+        .usage = batch.usage,
+        .systemUsage = batch.systemUsage
+    };
+    std::vector<VibrateInfoPtr> infos;
+    for (const auto &item : batch.items) {
+        VibrateInfo info = common;
+        ret = BuildBatchVibrateInfo(item, info);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        infos.push_back(std::make_shared<const VibrateInfo>(std::move(info)));
+    }
+    if (!IsVibrateAdmitted(batch.usage)) {
+        return ERROR;
+    }
+    {
+        std::lock_guard<std::mutex> guard(pidMutex_);
+        if (disablePids_.count(common.pid) != 0) {
+            MISC_HILOGE("Pid :%{public}d is disabled, reject vibration", common.pid);
+            return ERROR;
+        }
+    }
+    return StartVibrateBatch(batch, infos);
+}
+
+int32_t MiscdeviceService::BuildBatchVibrateInfo(const VibrateBatchItemIPC &item, VibrateInfo &info)
+{
+    if (item.mode == VIBRATE_TIME) {
+        if ((item.duration <= MIN_VIBRATOR_TIME) || (item.duration > MAX_VIBRATOR_TIME)) {
+            MISC_HILOGE("Invalid duration:%{public}d", item.duration);
+            return PARAMETER_ERROR;
+        }
+        timeModeCallTimes_ += 1;
+        info.mode = VIBRATE_TIME;
+        info.duration = item.duration;
+        return ERR_OK;
+    }
+    if ((item.mode != VIBRATE_PRESET) || (item.count < MIN_VIBRATOR_COUNT) || (item.count > MAX_VIBRATOR_COUNT)) {
+        MISC_HILOGE("Invalid mode:%{public}d or count:%{public}d", item.mode, item.count);
+        return PARAMETER_ERROR;
+    }
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    std::optional<HdfEffectInfo> effectInfo = GetCachedEffectInfo(item.identifier, item.effect);
+    if (!effectInfo) {
+        MISC_HILOGE("GetEffectInfo fail");
+        return ERROR;
+    }
+    if (!(effectInfo->isSupportEffect)) {
+        MISC_HILOGE("Effect not supported");
+        return PARAMETER_ERROR;
+    }
+    info.duration = effectInfo->duration;
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+    presetModeCallTimes_ += 1;
+    info.mode = VIBRATE_PRESET;
+    info.effect = item.effect;
+    info.count = item.count;
+    info.intensity = INTENSITY_ADJUST_MAX;
+    return ERR_OK;
+}
+
+int32_t MiscdeviceService::StartVibrateBatch(const VibrateBatchIPC &batch, const std::vector<VibrateInfoPtr> &infos)
+{
+    std::vector<std::pair<VibrateInfoPtr, VibratorTarget>> playbacks;
+    std::vector<VibratorTarget> allTargets;
+    std::set<std::pair<int32_t, int32_t>> motors;
+    for (size_t i = 0; i < batch.items.size(); ++i) {
+        std::vector<VibratorTarget> targets = ResolveVibratorTargets(batch.items[i].identifier);
+        if (targets.empty()) {
+            MISC_HILOGE("No vibrator found, deviceId:%{public}d", batch.items[i].identifier.deviceId);
+            return ERROR;
+        }
+        for (const auto &target : targets) {
+            if (!motors.emplace(target.identifier.deviceId, target.identifier.vibratorId).second) {
+                MISC_HILOGE("Motor %{public}d of device %{public}d appears twice in the batch",
+                    target.identifier.vibratorId, target.identifier.deviceId);
+                return PARAMETER_ERROR;
+            }
+            playbacks.emplace_back(infos[i], target);
+            allTargets.push_back(target);
+        }
+    }
+    /** Arbitrated under all device locks at once, so either every motor starts or none is touched */
+    auto playbackLocks = LockPlayback(allTargets);
+    for (const auto &[info, target] : playbacks) {
+        if (target.identifier.isLocalVibrator && ShouldIgnoreVibrate(*info, target)) {
+            MISC_HILOGE("Vibration batch is ignored, motor %{public}d of device %{public}d is busy",
+                target.identifier.vibratorId, target.identifier.deviceId);
+            return ERROR;
+        }
+    }
+    std::shared_ptr<PlaybackGroup> group = (playbacks.size() > 1) ? CreatePlaybackGroup(allTargets) : nullptr;
+    for (const auto &[info, target] : playbacks) {
+        StartVibrateThread(info, target, group);
+    }
+    MISC_HILOGW("Start vibrator batch, package:%{public}s, pid:%{public}d, usage:%{public}d, motors:%{public}zu",
+        infos.front()->packageName.c_str(), infos.front()->pid, batch.usage, playbacks.size());
+    return NO_ERROR;
+}
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "package_name_cache.h"
+
+namespace OHOS {
+namespace Sensors {
+PackageNameCache::PackageNameCache(size_t capacity) : capacity_(capacity) {}
+
+bool PackageNameCache::Find(uint32_t tokenId, std::string &packageName)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto it = index_.find(tokenId);
+    if (it == index_.end()) {
+        return false;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    packageName = it->second->second;
+    return true;
+}
+
+void PackageNameCache::Insert(uint32_t tokenId, const std::string &packageName)
+{
+    if (capacity_ == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto it = index_.find(tokenId);
+    if (it != index_.end()) {
+        it->second->second = packageName;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+    if (entries_.size() >= capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    entries_.emplace_front(tokenId, packageName);
+    index_[tokenId] = entries_.begin();
+}
+
+void PackageNameCache::Erase(uint32_t tokenId)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto it = index_.find(tokenId);
+    if (it == index_.end()) {
+        return;
+    }
+    entries_.erase(it->second);
+    index_.erase(it);
+}
+
+void PackageNameCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    entries_.clear();
+    index_.clear();
+}
+
+size_t PackageNameCache::Size()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return entries_.size();
+}
+}  // namespace Sensors
+}  // namespace OHOS
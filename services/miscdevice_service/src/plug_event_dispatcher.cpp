@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plug_event_dispatcher.h"
+
+#include <algorithm>
+#include <sys/prctl.h>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PlugEventDispatcher"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr size_t PLUG_EVENT_QUEUE_CAPACITY = 8;
+constexpr size_t PLUG_EVENT_WORKER_NUM = 2;
+constexpr int64_t PLUG_EVENT_LAG_THRESHOLD_MS = 100;
+const std::string PLUG_EVENT_THREAD_NAME = "OS_MiscPlugEvt";
+}  // namespace
+
+PlugEventDispatcher::~PlugEventDispatcher()
+{
+    Shutdown();
+}
+
+void PlugEventDispatcher::Subscribe(uintptr_t clientId, PlugEventSink sink)
+{
+    if (sink == nullptr) {
+        MISC_HILOGE("Sink is nullptr");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(dispatchMutex_);
+    if (quit_) {
+        return;
+    }
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->sink = std::move(sink);
+    subscribers_[clientId] = subscriber;
+    while (workers_.size() < PLUG_EVENT_WORKER_NUM) {
+        workers_.emplace_back(&PlugEventDispatcher::Run, this);
+    }
+}
+
+void PlugEventDispatcher::Unsubscribe(uintptr_t clientId)
+{
+    std::lock_guard<std::mutex> lock(dispatchMutex_);
+    subscribers_.erase(clientId);
+}
+
+void PlugEventDispatcher::Publish(int32_t status, int32_t deviceId, int32_t vibratorCnt)
+{
+    VibratorPlugEvent event = {
+        .status = status,
+        .deviceId = deviceId,
+        .vibratorCnt = vibratorCnt,
+        .postTime = std::chrono::steady_clock::now()
+    };
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex_);
+        ++stats_.published;
+        for (auto &[clientId, subscriber] : subscribers_) {
+            /** Only a repeat of the same state is merged, an opposite one must still reach the client in order */
+            auto pending = std::find_if(subscriber->events.begin(), subscriber->events.end(),
+                [deviceId, status](const VibratorPlugEvent &queued) {
+                    return (queued.deviceId == deviceId) && (queued.status == status);
+                });
+            if (pending != subscriber->events.end()) {
+                subscriber->events.erase(pending);
+                ++stats_.coalesced;
+            } else if (subscriber->events.size() >= PLUG_EVENT_QUEUE_CAPACITY) {
+                subscriber->events.pop_front();
+                ++stats_.dropped;
+            }
+            subscriber->events.push_back(event);
+            stats_.maxDepth = std::max(stats_.maxDepth, subscriber->events.size());
+            if (!subscriber->scheduled) {
+                subscriber->scheduled = true;
+                readyClients_.push_back(clientId);
+            }
+        }
+    }
+    dispatchCv_.notify_all();
+}
+
+void PlugEventDispatcher::Run()
+{
+    prctl(PR_SET_NAME, PLUG_EVENT_THREAD_NAME.c_str());
+    std::unique_lock<std::mutex> lock(dispatchMutex_);
+    while (true) {
+        dispatchCv_.wait(lock, [this] { return quit_ || !readyClients_.empty(); });
+        if (quit_) {
+            break;
+        }
+        uintptr_t clientId = readyClients_.front();
+        readyClients_.pop_front();
+        auto it = subscribers_.find(clientId);
+        if ((it == subscribers_.end()) || it->second->inFlight) {
+            continue;
+        }
+        std::shared_ptr<Subscriber> subscriber = it->second;
+        if (subscriber->events.empty()) {
+            subscriber->scheduled = false;
+            continue;
+        }
+        VibratorPlugEvent event = subscriber->events.front();
+        subscriber->events.pop_front();
+        subscriber->inFlight = true;
+        lock.unlock();
+        subscriber->sink(event);
+        lock.lock();
+        auto lagMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - event.postTime).count();
+        ++stats_.delivered;
+        stats_.maxLagMs = std::max<int64_t>(stats_.maxLagMs, lagMs);
+        if (lagMs >= PLUG_EVENT_LAG_THRESHOLD_MS) {
+            ++stats_.lagged;
+        }
+        subscriber->inFlight = false;
+        it = subscribers_.find(clientId);
+        if ((it == subscribers_.end()) || (it->second != subscriber)) {
+            continue;
+        }
+        if (subscriber->events.empty()) {
+            subscriber->scheduled = false;
+        } else {
+            readyClients_.push_back(clientId);
+            dispatchCv_.notify_one();
+        }
+    }
+}
+
+void PlugEventDispatcher::Shutdown()
+{
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(dispatchMutex_);
+        quit_ = true;
+        subscribers_.clear();
+        readyClients_.clear();
+        workers.swap(workers_);
+    }
+    dispatchCv_.notify_all();
+    for (auto &worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+PlugEventStats PlugEventDispatcher::GetStats()
+{
+    std::lock_guard<std::mutex> lock(dispatchMutex_);
+    PlugEventStats stats = stats_;
+    stats.subscribers = subscribers_.size();
+    return stats;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrate_coalescer.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Sensors {
+bool VibrateCoalescer::TryMerge(const VibratorIdentifierIPC &identifier, const VibrateInfo &info)
+{
+    return TryMerge(identifier, info, std::chrono::steady_clock::now());
+}
+
+bool VibrateCoalescer::TryMerge(const VibratorIdentifierIPC &identifier, const VibrateInfo &info,
+    std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(coalesceMutex_);
+    if (!IsCandidate(info)) {
+        return false;
+    }
+    ++candidates_;
+    auto it = lastPresets_.find(std::make_pair(identifier.deviceId, identifier.vibratorId));
+    if (it == lastPresets_.end()) {
+        return false;
+    }
+    const LastPreset &last = it->second;
+    int32_t window = (last.duration > 0) ? std::min(windowMs_, last.duration) : windowMs_;
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last.startTime).count();
+    if ((info.effect != last.effect) || (info.pid != last.pid) || (info.usage != last.usage) ||
+        (info.intensity > last.intensity) || (elapsed < 0) || (elapsed >= window)) {
+        return false;
+    }
+    ++merged_;
+    return true;
+}
+
+void VibrateCoalescer::Record(const VibratorIdentifierIPC &identifier, const VibrateInfo &info)
+{
+    Record(identifier, info, std::chrono::steady_clock::now());
+}
+
+void VibrateCoalescer::Record(const VibratorIdentifierIPC &identifier, const VibrateInfo &info,
+    std::chrono::steady_clock::time_point now)
+{
+    std::pair<int32_t, int32_t> motor(identifier.deviceId, identifier.vibratorId);
+    std::lock_guard<std::mutex> lock(coalesceMutex_);
+    if (!IsCandidate(info)) {
+        lastPresets_.erase(motor);
+        return;
+    }
+    LastPreset &last = lastPresets_[motor];
+    last.effect = info.effect;
+    last.pid = info.pid;
+    last.usage = info.usage;
+    last.intensity = info.intensity;
+    last.duration = info.duration;
+    last.startTime = now;
+}
+
+bool VibrateCoalescer::IsCandidate(const VibrateInfo &info) const
+{
+    return (windowMs_ > 0) && (info.mode == VIBRATE_PRESET) && (info.count == 1) &&
+        (info.duration <= MAX_COALESCE_DURATION);
+}
+
+void VibrateCoalescer::Reset(const VibratorIdentifierIPC &identifier)
+{
+    std::lock_guard<std::mutex> lock(coalesceMutex_);
+    lastPresets_.erase(std::make_pair(identifier.deviceId, identifier.vibratorId));
+}
+
+void VibrateCoalescer::SetWindow(int32_t windowMs)
+{
+    std::lock_guard<std::mutex> lock(coalesceMutex_);
+    windowMs_ = std::max(windowMs, 0);
+    lastPresets_.clear();
+}
+
+VibrateCoalesceStats VibrateCoalescer::GetStats()
+{
+    std::lock_guard<std::mutex> lock(coalesceMutex_);
+    VibrateCoalesceStats stats;
+    stats.windowMs = windowMs_;
+    stats.candidates = candidates_;
+    stats.merged = merged_;
+    return stats;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrate_rate_limiter.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr double MILLIS_PER_SECOND = 1000.0;
+constexpr uint32_t PID_SHIFT = 32;
+
+uint64_t BucketKey(int32_t pid, int32_t usage)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(pid)) << PID_SHIFT) | static_cast<uint32_t>(usage);
+}
+}  // namespace
+
+size_t VibrateRateLimiter::GetBucketCount()
+{
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    return buckets_.size();
+}
+
+bool VibrateRateLimiter::TryAcquire(int32_t pid, int32_t uid, int32_t usage)
+{
+    return TryAcquire(pid, uid, usage, std::chrono::steady_clock::now());
+}
+
+bool VibrateRateLimiter::TryAcquire(int32_t pid, int32_t uid, int32_t usage,
+    std::chrono::steady_clock::time_point now)
+{
+    if ((usage < 0) || (usage >= USAGE_MAX)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    const VibrateRateConfig &config = configs_[usage];
+    if (config.ratePerSecond == 0) {
+        ++admitted_[usage];
+        return true;
+    }
+    uint64_t key = BucketKey(pid, usage);
+    auto it = buckets_.find(key);
+    if (it == buckets_.end()) {
+        if (buckets_.size() >= MAX_RATE_BUCKETS) {
+            EvictIdleBuckets(now);
+        }
+        if (buckets_.size() >= MAX_RATE_BUCKETS) {
+            EvictLeastRecentBucket();
+        }
+        Bucket bucket;
+        bucket.tokens = config.burst;
+        bucket.lastRefill = now;
+        it = buckets_.emplace(key, bucket).first;
+    }
+    Bucket &bucket = it->second;
+    bucket.uid = uid;
+    bucket.lastUsed = now;
+    Refill(bucket, config, now);
+    if (bucket.tokens < 1.0) {
+        ++bucket.rejected;
+        ++rejected_[usage];
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    ++admitted_[usage];
+    return true;
+}
+
+void VibrateRateLimiter::Refill(Bucket &bucket, const VibrateRateConfig &config,
+    std::chrono::steady_clock::time_point now)
+{
+    if (now <= bucket.lastRefill) {
+        return;
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - bucket.lastRefill).count();
+    bucket.tokens = std::min(static_cast<double>(config.burst),
+        bucket.tokens + elapsedMs * config.ratePerSecond / MILLIS_PER_SECOND);
+    bucket.lastRefill = now;
+}
+
+void VibrateRateLimiter::EvictIdleBuckets(std::chrono::steady_clock::time_point now)
+{
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+        int32_t usage = static_cast<int32_t>(it->first & UINT32_MAX);
+        Refill(it->second, configs_[usage], now);
+        if (it->second.tokens >= configs_[usage].burst) {
+            it = buckets_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void VibrateRateLimiter::EvictLeastRecentBucket()
+{
+    auto leastRecent = std::min_element(buckets_.begin(), buckets_.end(),
+        [](const auto &left, const auto &right) { return left.second.lastUsed < right.second.lastUsed; });
+    if (leastRecent != buckets_.end()) {
+        buckets_.erase(leastRecent);
+    }
+}
+
+void VibrateRateLimiter::SetRateConfig(int32_t usage, const VibrateRateConfig &config)
+{
+    if ((usage < 0) || (usage >= USAGE_MAX)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    configs_[usage] = config;
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+        if (static_cast<int32_t>(it->first & UINT32_MAX) == usage) {
+            it = buckets_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void VibrateRateLimiter::Erase(int32_t pid)
+{
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        buckets_.erase(BucketKey(pid, usage));
+    }
+}
+
+std::vector<VibrateRateStats> VibrateRateLimiter::GetStats()
+{
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    std::vector<VibrateRateStats> stats;
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        VibrateRateStats usageStats;
+        usageStats.usage = usage;
+        usageStats.config = configs_[usage];
+        usageStats.admitted = admitted_[usage];
+        usageStats.rejected = rejected_[usage];
+        stats.push_back(usageStats);
+    }
+    return stats;
+}
+
+std::vector<VibrateRejectedCaller> VibrateRateLimiter::GetRejectedCallers()
+{
+    std::lock_guard<std::mutex> lock(limiterMutex_);
+    std::vector<VibrateRejectedCaller> callers;
+    for (const auto &[key, bucket] : buckets_) {
+        if (bucket.rejected == 0) {
+            continue;
+        }
+        VibrateRejectedCaller caller;
+        caller.pid = static_cast<int32_t>(key >> PID_SHIFT);
+        caller.uid = bucket.uid;
+        caller.usage = static_cast<int32_t>(key & UINT32_MAX);
+        caller.rejected = bucket.rejected;
+        callers.push_back(caller);
+    }
+    return callers;
+}
+}  // namespace Sensors
+}  // namespace OHOS
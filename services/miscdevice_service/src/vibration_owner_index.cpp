@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibration_owner_index.h"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr uint32_t MOTOR_KEY_SHIFT = 32;
+} // namespace
+
+uint64_t VibrationOwnerIndex::GetMotorKey(int32_t deviceId, int32_t vibratorId)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(deviceId)) << MOTOR_KEY_SHIFT) |
+        static_cast<uint32_t>(vibratorId);
+}
+
+void VibrationOwnerIndex::Bind(int32_t pid, const VibratorIdentifierIPC &identifier, uint32_t sessionId)
+{
+    uint64_t motorKey = GetMotorKey(identifier.deviceId, identifier.vibratorId);
+    std::lock_guard<std::mutex> lock(ownerMutex_);
+    auto it = motorOwners_.find(motorKey);
+    if ((it != motorOwners_.end()) && (it->second.pid == pid)) {
+        it->second.sessionId = sessionId;
+        return;
+    }
+    UnbindLocked(motorKey);
+    motorOwners_[motorKey] = MotorOwner { pid, sessionId };
+    ownedMotors_[pid].insert(motorKey);
+}
+
+bool VibrationOwnerIndex::Unbind(const VibratorIdentifierIPC &identifier)
+{
+    std::lock_guard<std::mutex> lock(ownerMutex_);
+    return UnbindLocked(GetMotorKey(identifier.deviceId, identifier.vibratorId));
+}
+
+bool VibrationOwnerIndex::UnbindSession(const VibratorIdentifierIPC &identifier, uint32_t sessionId)
+{
+    uint64_t motorKey = GetMotorKey(identifier.deviceId, identifier.vibratorId);
+    std::lock_guard<std::mutex> lock(ownerMutex_);
+    auto it = motorOwners_.find(motorKey);
+    if ((it == motorOwners_.end()) || (it->second.sessionId != sessionId)) {
+        return false;
+    }
+    return UnbindLocked(motorKey);
+}
+
+std::vector<OwnedVibration> VibrationOwnerIndex::Release(int32_t pid)
+{
+    std::vector<OwnedVibration> owned;
+    std::lock_guard<std::mutex> lock(ownerMutex_);
+    auto it = ownedMotors_.find(pid);
+    if (it == ownedMotors_.end()) {
+        return owned;
+    }
+    for (uint64_t motorKey : it->second) {
+        OwnedVibration vibration;
+        vibration.identifier.deviceId = static_cast<int32_t>(motorKey >> MOTOR_KEY_SHIFT);
+        vibration.identifier.vibratorId = static_cast<int32_t>(static_cast<uint32_t>(motorKey));
+        auto ownerIt = motorOwners_.find(motorKey);
+        if (ownerIt != motorOwners_.end()) {
+            vibration.sessionId = ownerIt->second.sessionId;
+            motorOwners_.erase(ownerIt);
+        }
+        owned.push_back(vibration);
+    }
+    ownedMotors_.erase(it);
+    return owned;
+}
+
+size_t VibrationOwnerIndex::GetOwnerCount()
+{
+    std::lock_guard<std::mutex> lock(ownerMutex_);
+    return ownedMotors_.size();
+}
+
+bool VibrationOwnerIndex::UnbindLocked(uint64_t motorKey)
+{
+    auto it = motorOwners_.find(motorKey);
+    if (it == motorOwners_.end()) {
+        return false;
+    }
+    auto ownedIt = ownedMotors_.find(it->second.pid);
+    if (ownedIt != ownedMotors_.end()) {
+        ownedIt->second.erase(motorKey);
+        if (ownedIt->second.empty()) {
+            ownedMotors_.erase(ownedIt);
+        }
+    }
+    motorOwners_.erase(it);
+    return true;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -30,6 +30,7 @@
 #include "os_account_manager.h"
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_INPUT_METHOD
 
+#include "hdi_executor.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -962,27 +963,40 @@ VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &v
         MISC_HILOGD("Can vibrate, loop priority is high");
         return VIBRATION;
     }
-    return ShouldIgnoreVibrate(vibrateInfo, vibratorThread->GetCurrentVibrateInfo());
+    VibrateInfoPtr currentVibrateInfo = vibratorThread->GetCurrentVibrateInfo();
+    return ShouldIgnoreVibrate(vibrateInfo, *currentVibrateInfo);
 }
 
 bool VibrationPriorityManager::IsCurrentVibrate(const std::shared_ptr<VibratorThread> &vibratorThread,
     const VibratorIdentifierIPC& identifier) const
 {
 #if defined(OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM) && defined(HDF_DRIVERS_INTERFACE_VIBRATOR)
-    return ((vibratorThread != nullptr) && (vibratorThread->IsRunning() ||
-        VibratorDevice.IsVibratorRunning(identifier)));
+    if (vibratorThread == nullptr) {
+        return false;
+    }
+    if (vibratorThread->IsPlaying()) {
+        return true;
+    }
+    /** Asked on the device lane, so the answer already reflects the stops and plays queued before it */
+    bool running = false;
+    if (!HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, identifier.deviceId, [&running, &identifier]() {
+        running = VibratorDevice.IsVibratorRunning(identifier);
+    })) {
+        MISC_HILOGW("Query vibrator state fail, deviceId:%{public}d", identifier.deviceId);
+    }
+    return running;
 #else
-    return ((vibratorThread != nullptr) && (vibratorThread->IsRunning()));
+    return ((vibratorThread != nullptr) && (vibratorThread->IsPlaying()));
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM && HDF_DRIVERS_INTERFACE_VIBRATOR
 }
 
 bool VibrationPriorityManager::IsLoopVibrate(const VibrateInfo &vibrateInfo) const
 {
-    return ((vibrateInfo.mode == "preset") && (vibrateInfo.count > 1));
+    return ((vibrateInfo.mode == VIBRATE_PRESET) && (vibrateInfo.count > 1));
 }
 
 VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo,
-    VibrateInfo currentVibrateInfo) const
+    const VibrateInfo &currentVibrateInfo) const
 {
     if (currentVibrateInfo.usage == USAGE_ALARM) {
         MISC_HILOGD("Vibration is ignored for alarm");
@@ -1139,4 +1153,4 @@ void VibrationPriorityManager::SetIgnoreSwitchStatus(bool status)
     isVibratorMute_.store(status);
 }
 }  // namespace Sensors
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
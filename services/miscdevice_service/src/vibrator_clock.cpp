@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrator_clock.h"
+
+#include <thread>
+
+namespace OHOS {
+namespace Sensors {
+std::shared_ptr<VibratorClock> VibratorClock::GetSteadyClock()
+{
+    static std::shared_ptr<VibratorClock> steadyClock = std::make_shared<SteadyVibratorClock>();
+    return steadyClock;
+}
+
+VibratorClock::TimePoint SteadyVibratorClock::Now()
+{
+    return std::chrono::steady_clock::now();
+}
+
+bool SteadyVibratorClock::WaitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+    TimePoint deadline, const std::function<bool()> &pred)
+{
+    return cv.wait_until(lock, deadline, pred);
+}
+
+void SteadyVibratorClock::SleepFor(std::chrono::microseconds duration)
+{
+    std::this_thread::sleep_for(duration);
+}
+
+VirtualVibratorClock::VirtualVibratorClock() : now_(std::chrono::steady_clock::now()) {}
+
+VibratorClock::TimePoint VirtualVibratorClock::Now()
+{
+    std::lock_guard<std::mutex> nowLock(nowMutex_);
+    return now_;
+}
+
+bool VirtualVibratorClock::WaitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+    TimePoint deadline, const std::function<bool()> &pred)
+{
+    if (pred()) {
+        return true;
+    }
+    AdvanceTo(deadline);
+    return pred();
+}
+
+void VirtualVibratorClock::SleepFor(std::chrono::microseconds duration)
+{
+    Advance(duration);
+}
+
+void VirtualVibratorClock::Advance(std::chrono::microseconds duration)
+{
+    std::lock_guard<std::mutex> nowLock(nowMutex_);
+    now_ += duration;
+}
+
+void VirtualVibratorClock::AdvanceTo(TimePoint timePoint)
+{
+    std::lock_guard<std::mutex> nowLock(nowMutex_);
+    if (timePoint > now_) {
+        now_ = timePoint;
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
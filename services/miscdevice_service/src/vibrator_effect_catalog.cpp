@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrator_effect_catalog.h"
+
+namespace OHOS {
+namespace Sensors {
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+void VibratorEffectCatalog::AddDevice(int32_t deviceId)
+{
+    std::lock_guard<std::mutex> lock(catalogMutex_);
+    (void)catalog_.emplace(deviceId, DeviceEffects());
+}
+
+std::optional<HdfEffectInfo> VibratorEffectCatalog::Find(int32_t deviceId, const std::string &effect)
+{
+    std::lock_guard<std::mutex> lock(catalogMutex_);
+    auto deviceIt = catalog_.find(deviceId);
+    if (deviceIt == catalog_.end()) {
+        return std::nullopt;
+    }
+    DeviceEffects &device = deviceIt->second;
+    auto it = device.effects.find(effect);
+    if (it == device.effects.end()) {
+        ++device.misses;
+        return std::nullopt;
+    }
+    ++device.hits;
+    return it->second;
+}
+
+void VibratorEffectCatalog::Insert(int32_t deviceId, const std::string &effect, const HdfEffectInfo &effectInfo)
+{
+    std::lock_guard<std::mutex> lock(catalogMutex_);
+    auto deviceIt = catalog_.find(deviceId);
+    if (deviceIt != catalog_.end()) {
+        deviceIt->second.effects[effect] = effectInfo;
+    }
+}
+
+void VibratorEffectCatalog::Erase(int32_t deviceId)
+{
+    std::lock_guard<std::mutex> lock(catalogMutex_);
+    catalog_.erase(deviceId);
+}
+
+std::vector<EffectCatalogStats> VibratorEffectCatalog::GetStats()
+{
+    std::lock_guard<std::mutex> lock(catalogMutex_);
+    std::vector<EffectCatalogStats> stats;
+    for (const auto &[deviceId, device] : catalog_) {
+        EffectCatalogStats deviceStats;
+        deviceStats.deviceId = deviceId;
+        deviceStats.hits = device.hits;
+        deviceStats.misses = device.misses;
+        deviceStats.effects.assign(device.effects.begin(), device.effects.end());
+        stats.push_back(std::move(deviceStats));
+    }
+    return stats;
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+}  // namespace Sensors
+}  // namespace OHOS
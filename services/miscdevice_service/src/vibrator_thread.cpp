@@ -15,13 +15,27 @@
 
 #include "vibrator_thread.h"
 
+#include <cinttypes>
 #include <sys/prctl.h>
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+#include <algorithm>
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
 
 #include "custom_vibration_matcher.h"
+#include "hdi_executor.h"
 #ifdef OHOS_BUILD_ENABLE_QOS
 #include "concurrent_task_client.h"
 #include "qos.h"
 #endif // OHOS_BUILD_ENABLE_QOS
+#include "miscdevice_dump.h"
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+#include "parameters.h"
+#include "securec.h"
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -35,66 +49,214 @@ constexpr int32_t DELAY_TIME1 = 5;    /** ms */
 constexpr int32_t DELAY_TIME2 = 10;   /** ms */
 constexpr size_t RETRY_NUMBER = 6;
 constexpr int32_t MAX_VIBRATE_COUNT = 1000;
+constexpr int64_t DISPATCH_COST_WEIGHT = 4;
+constexpr int64_t MAX_DISPATCH_COST_US = 20000;
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+/** Product tunables, e.g. const.miscdevice.vibrator.rt_policy=fifo and const.miscdevice.vibrator.rt_cpus=4-7 */
+const std::string RT_POLICY_PARAM = "const.miscdevice.vibrator.rt_policy";
+const std::string RT_PRIORITY_PARAM = "const.miscdevice.vibrator.rt_priority";
+const std::string RT_CPUS_PARAM = "const.miscdevice.vibrator.rt_cpus";
+const std::string RT_MLOCK_PARAM = "const.miscdevice.vibrator.rt_mlock";
+constexpr int32_t DEFAULT_RT_PRIORITY = 1;
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+constexpr size_t HAPTIC_PAKET_LOOKAHEAD = 2;
 constexpr size_t COMPOSITE_EFFECT_PART = 128;
+constexpr size_t COMPOSITE_EFFECT_BUFFERS = 2;
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+const VibrateInfoPtr IDLE_VIBRATE_INFO = std::make_shared<const VibrateInfo>();
+const WaveInfosPtr EMPTY_WAVE_INFOS = std::make_shared<const std::vector<HdfWaveInformation>>();
 }  // namespace
 
+PlaybackGroup::PlaybackGroup(std::chrono::steady_clock::time_point startTime, size_t motorCount)
+    : startTime_(startTime), motorCount_(motorCount) {}
+
+std::chrono::steady_clock::time_point PlaybackGroup::GetStartTime() const
+{
+    return startTime_;
+}
+
+void PlaybackGroup::ReportStart(int32_t vibratorId, int64_t latenessUs)
+{
+    std::lock_guard<std::mutex> reportLck(reportMutex_);
+    if (startedCount_ == 0) {
+        minLatenessUs_ = latenessUs;
+        maxLatenessUs_ = latenessUs;
+    } else {
+        minLatenessUs_ = std::min(minLatenessUs_, latenessUs);
+        maxLatenessUs_ = std::max(maxLatenessUs_, latenessUs);
+    }
+    ++startedCount_;
+    MISC_HILOGD("VibratorId:%{public}d, group start lateness:%{public}" PRId64 "us", vibratorId, latenessUs);
+    if (startedCount_ == motorCount_) {
+        MISC_HILOGI("Group started, motors:%{public}zu, skew:%{public}" PRId64 "us, maxLateness:%{public}" PRId64 "us",
+            motorCount_, maxLatenessUs_ - minLatenessUs_, maxLatenessUs_);
+    }
+}
+
+void PlaybackGroup::AddPartition(int32_t position, VibratePackage &&package)
+{
+    partitions_.emplace(position, std::move(package));
+}
+
+const VibratePackage *PlaybackGroup::GetPartition(int32_t position) const
+{
+    auto it = partitions_.find(position);
+    return (it != partitions_.end()) ? &(it->second) : nullptr;
+}
+
+VibratorThread::VibratorThread() : currentVibration_(IDLE_VIBRATE_INFO), waveInfos_(EMPTY_WAVE_INFOS) {}
+
+VibratorThread::~VibratorThread()
+{
+    {
+        std::lock_guard<std::mutex> commandLck(commandMutex_);
+        quit_ = true;
+        commandQueue_.clear();
+        exitFlag_.store(true);
+    }
+    commandCv_.notify_one();
+    {
+        std::lock_guard<std::mutex> vibrateLck(vibrateMutex_);
+        cv_.notify_one();
+    }
+    NotifyExitSync();
+}
+
 bool VibratorThread::Run()
 {
-    CALL_LOG_ENTER;
-    prctl(PR_SET_NAME, VIBRATE_CONTROL_THREAD_NAME.c_str());
+    if (!workerInitialized_) {
+        prctl(PR_SET_NAME, VIBRATE_CONTROL_THREAD_NAME.c_str());
 #ifdef OHOS_BUILD_ENABLE_QOS
-    SetQosForThread();
+        SetQosForThread();
 #endif // OHOS_BUILD_ENABLE_QOS
-    VibrateInfo info = GetCurrentVibrateInfo();
-    VibratorIdentifierIPC identifier = GetCurrentVibrateParams();
-    std::vector<HdfWaveInformation> waveInfos = GetCurrentWaveInfo();
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+        SetRealTimeProfile();
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+        workerInitialized_ = true;
+    }
+    VibratorCommand command;
+    bool blocked = false;
+    {
+        std::unique_lock<std::mutex> commandLck(commandMutex_);
+        blocked = commandQueue_.empty();
+        commandCv_.wait(commandLck, [this] { return quit_ || !commandQueue_.empty(); });
+        if (quit_) {
+            MISC_HILOGI("Vibrator worker exit");
+            return false;
+        }
+        command = std::move(commandQueue_.front());
+        commandQueue_.pop_front();
+        exitFlag_.store(!commandQueue_.empty());
+    }
+    if (blocked) {
+        DumpHelper->SaveWakeupLatency(WAKEUP_COMMAND, std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_->Now() - command.postTime).count());
+    }
+    ExecuteCommand(command);
+    return true;
+}
+
+void VibratorThread::ExecuteCommand(const VibratorCommand &command)
+{
+    if (command.type != VibratorCommandType::STOP) {
+        int32_t ret = PlayVibration(command);
+        if (ret != SUCCESS) {
+            MISC_HILOGE("Play vibration fail, mode:%{public}s, package:%{public}s",
+                GetVibrateModeName(command.info->mode).c_str(), command.info->packageName.c_str());
+        }
+    }
+    FinishCommand(command.generation);
+}
+
+int32_t VibratorThread::PlayVibration(const VibratorCommand &command)
+{
+    const VibrateInfo &info = *command.info;
+    const VibratorIdentifierIPC &identifier = command.identifier;
     MISC_HILOGD("info.mode:%{public}s, deviceId:%{public}d, vibratorId:%{public}d",
-                info.mode.c_str(), identifier.deviceId, identifier.vibratorId);
+                GetVibrateModeName(info.mode).c_str(), identifier.deviceId, identifier.vibratorId);
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    /** The service queued the motor stop on the device lane ahead of this playback */
+    MarkMotorIdle();
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    if (command.group != nullptr) {
+        auto startTime = command.group->GetStartTime();
+        if (WaitUntil(startTime)) {
+            MISC_HILOGD("Group playback cancelled before start, package:%{public}s", info.packageName.c_str());
+            return SUCCESS;
+        }
+        command.group->ReportStart(identifier.vibratorId, std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_->Now() - startTime).count());
+    }
     if (info.mode == VIBRATE_TIME) {
         int32_t ret = PlayOnce(info, identifier);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play once vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
+            return ERROR;
         }
     } else if (info.mode == VIBRATE_PRESET) {
         int32_t ret = PlayEffect(info, identifier);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play effect vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
+            return ERROR;
         }
     } else if (info.mode == VIBRATE_CUSTOM_HD) {
         int32_t ret = PlayCustomByHdHptic(info, identifier);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play custom vibration by hd haptic fail, package:%{public}s", info.packageName.c_str());
-            return false;
+            return ERROR;
         }
     } else if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT || info.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-        int32_t ret = PlayCustomByCompositeEffect(info, identifier, waveInfos);
+        const VibratePackage *partition =
+            (command.group != nullptr) ? command.group->GetPartition(identifier.position) : nullptr;
+        int32_t ret = PlayCustomByCompositeEffect(info, identifier, *command.waveInfos, partition);
         if (ret != SUCCESS) {
             MISC_HILOGE("Play custom vibration by composite effect fail, package:%{public}s", info.packageName.c_str());
-            return false;
+            return ERROR;
         }
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     }
+    return SUCCESS;
+}
+
+bool VibratorThread::WaitForExit(int32_t delayTime)
+{
+    return WaitUntil(clock_->Now() + std::chrono::milliseconds(delayTime));
+}
+
+bool VibratorThread::WaitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    bool blocked = false;
+    {
+        std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+        blocked = clock_->Now() < deadline;
+        if (clock_->WaitUntil(vibrateLck, cv_, deadline, [this] { return exitFlag_.load(); })) {
+            return true;
+        }
+    }
+    if (blocked) {
+        DumpHelper->SaveWakeupLatency(WAKEUP_TIMER, std::chrono::duration_cast<std::chrono::microseconds>(
+            clock_->Now() - deadline).count());
+    }
     return false;
 }
 
 int32_t VibratorThread::PlayOnce(const VibrateInfo &info, const VibratorIdentifierIPC& identifier)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    int32_t ret = VibratorDevice.StartOnce(identifier, static_cast<uint32_t>(info.duration));
+    int32_t ret = RunHdi(identifier, [&info, &identifier]() {
+        return VibratorDevice.StartOnce(identifier, static_cast<uint32_t>(info.duration));
+    });
     if (ret != SUCCESS) {
         MISC_HILOGE("StartOnce fail, duration:%{public}d", info.duration);
         return ERROR;
     }
-    cv_.wait_for(vibrateLck, std::chrono::milliseconds(info.duration), [this] { return exitFlag_.load(); });
-    if (exitFlag_) {
+    MarkMotorBusy(info.duration);
+    if (WaitForExit(info.duration)) {
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-        VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_ONCE);
+        StopMotor(identifier, HDF_VIBRATOR_MODE_ONCE);
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+        MarkMotorIdle();
         MISC_HILOGD("Stop duration:%{public}d, package:%{public}s", info.duration, info.packageName.c_str());
         return SUCCESS;
     }
@@ -103,44 +265,126 @@ int32_t VibratorThread::PlayOnce(const VibrateInfo &info, const VibratorIdentifi
 
 void VibratorThread::HandleMultipleVibrations(const VibratorIdentifierIPC& identifier)
 {
-    if (VibratorDevice.IsVibratorRunning(identifier)) {
-        VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_PRESET);
-        VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
+    if (motorStateKnown_) {
+        /** The end of the previous effect is predicted from its known duration, no HDI query is needed */
+        if (clock_->Now() < motorIdleAt_) {
+            StopMotor(identifier, HDF_VIBRATOR_MODE_PRESET);
+            StopMotor(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
+            MarkMotorIdle();
+        }
+        return;
+    }
+    if (IsMotorRunning(identifier)) {
+        StopMotor(identifier, HDF_VIBRATOR_MODE_PRESET);
+        StopMotor(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
         for (size_t i = 0; i < RETRY_NUMBER; i++) {
-            if (!VibratorDevice.IsVibratorRunning(identifier)) {
+            if (!IsMotorRunning(identifier)) {
                 MISC_HILOGI("No running vibration");
+                MarkMotorIdle();
                 return;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(DELAY_TIME1));
+            clock_->SleepFor(std::chrono::milliseconds(DELAY_TIME1));
         }
         MISC_HILOGW("Unstopped vibration");
+        return;
+    }
+    MarkMotorIdle();
+}
+
+void VibratorThread::MarkMotorBusy(int32_t duration)
+{
+    if (duration <= 0) {
+        motorStateKnown_ = false;
+        return;
+    }
+    motorStateKnown_ = true;
+    motorIdleAt_ = clock_->Now() + std::chrono::milliseconds(duration);
+}
+
+void VibratorThread::MarkMotorIdle()
+{
+    motorStateKnown_ = true;
+    motorIdleAt_ = clock_->Now();
+}
+
+int32_t VibratorThread::RunHdi(const VibratorIdentifierIPC& identifier, const std::function<int32_t()> &call)
+{
+    /** Runs on the device lane behind the service's queued HDI calls, so a play never overtakes a stop */
+    int32_t ret = ERROR;
+    if (!HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, identifier.deviceId, [&ret, &call]() { ret = call(); })) {
+        MISC_HILOGE("HDI queue of device %{public}d rejected the call", identifier.deviceId);
+        return ERROR;
     }
+    return ret;
+}
+
+bool VibratorThread::IsMotorRunning(const VibratorIdentifierIPC& identifier)
+{
+    return RunHdi(identifier, [&identifier]() {
+        return VibratorDevice.IsVibratorRunning(identifier) ? SUCCESS : ERROR;
+    }) == SUCCESS;
+}
+
+void VibratorThread::StopMotor(const VibratorIdentifierIPC& identifier, HdfVibratorMode mode)
+{
+    /** Queued behind the playback calls without waiting, a full queue never drops a stop */
+    bool posted = HdiExecutorPool.Post(HDI_DOMAIN_VIBRATOR, identifier.deviceId, [identifier, mode]() {
+        if (VibratorDevice.Stop(identifier, mode) != SUCCESS) {
+            MISC_HILOGW("Stop vibrator fail, mode:%{public}d", static_cast<int32_t>(mode));
+        }
+    }, true);
+    if (!posted) {
+        MISC_HILOGE("HDI queue of device %{public}d rejected the stop", identifier.deviceId);
+    }
+}
+
+bool VibratorThread::IsPreempted()
+{
+    std::lock_guard<std::mutex> commandLck(commandMutex_);
+    return !commandQueue_.empty() && (commandQueue_.front().type == VibratorCommandType::PREEMPT);
+}
+
+void VibratorThread::StopAbortedPlayback(const VibratorIdentifierIPC& identifier, HdfVibratorMode mode)
+{
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    /** The preempting request queued its own motor stop, a second one here could cut off its first HDI call */
+    if (IsPreempted()) {
+        return;
+    }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    StopMotor(identifier, mode);
 }
 
 int32_t VibratorThread::PlayEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
     if (info.count < 0 || info.count > MAX_VIBRATE_COUNT) {
         MISC_HILOGE("Vibratorinfo's count is invalid, count:%{public}d", info.count);
         return ERROR;
     }
+    const std::string &effect = info.effect;
+    /** The repetitions form one timeline with a fixed period, so per-iteration HDI latency never drifts the loop */
+    auto timelineStart = clock_->Now();
+    int64_t period = static_cast<int64_t>(info.duration) + DELAY_TIME2;
     for (int32_t i = 0; i < info.count; ++i) {
-        std::string effect = info.effect;
-        int32_t duration = info.duration;
+        auto iterationStart = timelineStart + std::chrono::milliseconds(period * i);
         if (i >= 1) { /**Multiple vibration treatment*/
             HandleMultipleVibrations(identifier);
-            duration += DELAY_TIME2;
         }
-        int32_t ret = VibratorDevice.StartByIntensity(identifier, effect, info.intensity);
+        int32_t ret = RunHdi(identifier, [&info, &identifier, &effect]() {
+            return VibratorDevice.StartByIntensity(identifier, effect, info.intensity);
+        });
         if (ret != SUCCESS) {
             MISC_HILOGE("Vibrate effect %{public}s failed, ", effect.c_str());
             return ERROR;
         }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(duration), [this] { return exitFlag_.load(); });
-        if (exitFlag_) {
+        MarkMotorBusy(info.duration);
+        auto deadline = (i + 1 < info.count) ? (iterationStart + std::chrono::milliseconds(period)) :
+            (iterationStart + std::chrono::milliseconds(info.duration));
+        if (WaitUntil(deadline)) {
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-            VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_PRESET);
+            StopAbortedPlayback(identifier, HDF_VIBRATOR_MODE_PRESET);
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+            MarkMotorIdle();
             MISC_HILOGD("Stop effect:%{public}s, package:%{public}s", effect.c_str(), info.packageName.c_str());
             return SUCCESS;
         }
@@ -150,44 +394,103 @@ int32_t VibratorThread::PlayEffect(const VibrateInfo &info, const VibratorIdenti
 
 int32_t VibratorThread::PlayCustomByHdHptic(const VibrateInfo &info, const VibratorIdentifierIPC& identifier)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
     const std::vector<VibratePattern> &patterns = info.package.patterns;
     size_t patternSize = patterns.size();
+    /** Every pattern is dispatched against an absolute deadline, so HDI latency never accumulates */
+    auto timelineStart = clock_->Now();
+    int64_t maxLatenessUs = 0;
+    int64_t totalLatenessUs = 0;
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    std::deque<HapticPaket> stagedPakets;
+    size_t stagedEnd = StageHapticPakets(patterns, 0, stagedPakets);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
     for (size_t i = 0; i < patternSize; ++i) {
-        int32_t delayTime;
-        if (i == 0) {
-            delayTime = patterns[i].startTime;
-        } else {
-            delayTime = patterns[i].startTime - patterns[i - 1].startTime;
-        }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
-        if (exitFlag_) {
+        auto deadline = timelineStart + std::chrono::milliseconds(patterns[i].startTime);
+        if (WaitUntil(deadline - std::chrono::microseconds(dispatchCostUs_))) {
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
-            VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
+            StopAbortedPlayback(identifier, HDF_VIBRATOR_MODE_HDHAPTIC);
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+            MarkMotorIdle();
             MISC_HILOGD("Stop hd haptic, package:%{public}s", info.packageName.c_str());
             return SUCCESS;
         }
+        auto dispatchBegin = clock_->Now();
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
         HandleMultipleVibrations(identifier);
+        int32_t ret = ERROR;
+        if (!stagedPakets.empty()) {
+            ret = RunHdi(identifier, [&identifier, &stagedPakets]() {
+                return VibratorDevice.PlayHapticPaket(identifier, stagedPakets.front());
+            });
+            stagedPakets.pop_front();
+        } else {
+            ret = RunHdi(identifier, [&identifier, &pattern = patterns[i]]() {
+                return VibratorDevice.PlayPattern(identifier, pattern);
+            });
+            /** Pattern i was played unstaged, staging resumes after it so the queue front stays pattern i + 1 */
+            stagedEnd = std::max(stagedEnd, i + 1);
+        }
+#else
+        int32_t ret = RunHdi(identifier, [&identifier, &pattern = patterns[i]]() {
+            return VibratorDevice.PlayPattern(identifier, pattern);
+        });
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
-        int32_t ret = VibratorDevice.PlayPattern(identifier, patterns[i]);
         if (ret != SUCCESS) {
             MISC_HILOGE("Vibrate hd haptic failed");
             return ERROR;
         }
+        MarkMotorBusy(patterns[i].patternDuration);
+        auto dispatchEnd = clock_->Now();
+        UpdateDispatchCost(std::chrono::duration_cast<std::chrono::microseconds>(dispatchEnd - dispatchBegin).count());
+        int64_t latenessUs = std::chrono::duration_cast<std::chrono::microseconds>(dispatchEnd - deadline).count();
+        MISC_HILOGD("Pattern:%{public}zu, startTime:%{public}d, lateness:%{public}" PRId64 "us",
+            i, patterns[i].startTime, latenessUs);
+        maxLatenessUs = std::max(maxLatenessUs, latenessUs);
+        totalLatenessUs += latenessUs;
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+        /** Pattern i is playing now, build the next ones before their deadlines come up */
+        stagedEnd = StageHapticPakets(patterns, stagedEnd, stagedPakets);
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+    }
+    if (patternSize > 0) {
+        MISC_HILOGI("Timeline done, patterns:%{public}zu, maxLateness:%{public}" PRId64 "us, "
+            "avgLateness:%{public}" PRId64 "us", patternSize, maxLatenessUs,
+            totalLatenessUs / static_cast<int64_t>(patternSize));
     }
     return SUCCESS;
 }
 
-VibrateInfo VibratorThread::copyInfoWithIndexEvents(const VibrateInfo& originalInfo,
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+size_t VibratorThread::StageHapticPakets(const std::vector<VibratePattern> &patterns, size_t begin,
+    std::deque<HapticPaket> &stagedPakets)
+{
+    size_t end = begin;
+    while ((end < patterns.size()) && (stagedPakets.size() < HAPTIC_PAKET_LOOKAHEAD)) {
+        HapticPaket packet;
+        if (VibratorDevice.PrepareHapticPaket(patterns[end], packet) != SUCCESS) {
+            MISC_HILOGW("Prepare haptic paket fail, stop staging at pattern:%{public}zu", end);
+            break;
+        }
+        stagedPakets.push_back(std::move(packet));
+        ++end;
+    }
+    return end;
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
+void VibratorThread::UpdateDispatchCost(int64_t costUs)
+{
+    dispatchCostUs_ = (dispatchCostUs_ * (DISPATCH_COST_WEIGHT - 1) + costUs) / DISPATCH_COST_WEIGHT;
+    dispatchCostUs_ = std::min(std::max(dispatchCostUs_, static_cast<int64_t>(0)), MAX_DISPATCH_COST_US);
+}
+
+VibratePackage VibratorThread::copyPackageWithIndexEvents(const VibratePackage& originalPackage,
     const VibratorIdentifierIPC& identifier)
 {
-    VibrateInfo newInfo = originalInfo;
     VibratePackage newPackage;
     int32_t parseDuration = 0;
 
-    for (const auto& pattern : originalInfo.package.patterns) {
+    for (const auto& pattern : originalPackage.patterns) {
         VibratePattern newPattern;
         newPattern.startTime = pattern.startTime;
         newPattern.patternDuration = pattern.patternDuration;
@@ -204,26 +507,30 @@ VibrateInfo VibratorThread::copyInfoWithIndexEvents(const VibrateInfo& originalI
         }
     }
 
-    newInfo.package = newPackage;
-    newInfo.package.packageDuration = parseDuration;
-    return newInfo;
+    newPackage.packageDuration = parseDuration;
+    return newPackage;
 }
 
 #ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
 int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier,
-    const std::vector<HdfWaveInformation> &waveInfo)
+    const std::vector<HdfWaveInformation> &waveInfo, const VibratePackage *partition)
 {
     CustomVibrationMatcher matcher(identifier, waveInfo);
     HdfCompositeEffect hdfCompositeEffect;
-    VibrateInfo newInfo = copyInfoWithIndexEvents(info, identifier);
-    if (newInfo.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT) {
+    if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT) {
         hdfCompositeEffect.type = HDF_EFFECT_TYPE_PRIMITIVE;
-        int32_t ret = matcher.TransformEffect(newInfo.package, hdfCompositeEffect.compositeEffects);
+        int32_t ret = ERROR;
+        if (partition != nullptr) {
+            ret = matcher.TransformEffect(*partition, hdfCompositeEffect.compositeEffects);
+        } else {
+            VibratePackage package = copyPackageWithIndexEvents(info.package, identifier);
+            ret = matcher.TransformEffect(package, hdfCompositeEffect.compositeEffects);
+        }
         if (ret != SUCCESS) {
             MISC_HILOGE("Transform pattern to predefined wave fail");
             return ERROR;
         }
-    } else if (newInfo.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
+    } else if (info.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
         hdfCompositeEffect.type = HDF_EFFECT_TYPE_TIME;
         int32_t ret = matcher.TransformTime(info.package, hdfCompositeEffect.compositeEffects);
         if (ret != SUCCESS) {
@@ -231,57 +538,230 @@ int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateInfo &info, con
             return ERROR;
         }
     }
-    return PlayCompositeEffect(newInfo, hdfCompositeEffect, identifier);
+    return PlayCompositeEffect(info, hdfCompositeEffect, identifier);
 }
 
 int32_t VibratorThread::PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect,
     const VibratorIdentifierIPC& identifier)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    HdfCompositeEffect effectsPart;
+    if (hdfCompositeEffect.compositeEffects.empty()) {
+        return SUCCESS;
+    }
+    int32_t startUpTime = GetCompositeStartUpTime(identifier, hdfCompositeEffect.type);
+    HdfCompositeEffect effectsParts[COMPOSITE_EFFECT_BUFFERS];
+    int32_t delayTimes[COMPOSITE_EFFECT_BUFFERS] = {0};
+    size_t current = 0;
+    size_t cursor = 0;
+    if (!BuildCompositeEffectPart(hdfCompositeEffect, cursor, effectsParts[current], delayTimes[current])) {
+        return ERROR;
+    }
+    auto partStart = clock_->Now();
+    int32_t ret = RunHdi(identifier, [&identifier, &effectsPart = effectsParts[current]]() {
+        return VibratorDevice.EnableCompositeEffect(identifier, effectsPart);
+    });
+    while (true) {
+        if (ret != SUCCESS) {
+            MISC_HILOGE("EnableCompositeEffect failed");
+            return ERROR;
+        }
+        MarkMotorBusy(delayTimes[current]);
+        auto partEnd = partStart + std::chrono::milliseconds(delayTimes[current]);
+        /** The following part is built while the current one plays, then submitted ahead by the start-up time */
+        size_t standby = (current + 1) % COMPOSITE_EFFECT_BUFFERS;
+        bool hasNext = (cursor < hdfCompositeEffect.compositeEffects.size());
+        if (hasNext &&
+            !BuildCompositeEffectPart(hdfCompositeEffect, cursor, effectsParts[standby], delayTimes[standby])) {
+            return ERROR;
+        }
+        auto wakeUp = hasNext ? (partEnd - std::chrono::milliseconds(startUpTime)) : partEnd;
+        if (WaitUntil(wakeUp)) {
+            StopAbortedPlayback(identifier, HDF_VIBRATOR_MODE_PRESET);
+            MarkMotorIdle();
+            MISC_HILOGD("Stop composite effect part, package:%{public}s", info.packageName.c_str());
+            return SUCCESS;
+        }
+        if (!hasNext) {
+            break;
+        }
+        ret = RunHdi(identifier, [&identifier, &effectsPart = effectsParts[standby]]() {
+            return VibratorDevice.EnableCompositeEffect(identifier, effectsPart);
+        });
+        partStart = partEnd;
+        current = standby;
+    }
+    return SUCCESS;
+}
+
+bool VibratorThread::BuildCompositeEffectPart(const HdfCompositeEffect &hdfCompositeEffect, size_t &cursor,
+    HdfCompositeEffect &effectsPart, int32_t &delayTime)
+{
     effectsPart.type = hdfCompositeEffect.type;
+    effectsPart.compositeEffects.clear();
+    delayTime = 0;
     size_t effectSize = hdfCompositeEffect.compositeEffects.size();
-    int32_t delayTime = 0;
-    for (size_t i = 0; i < effectSize; ++i) {
-        effectsPart.compositeEffects.push_back(hdfCompositeEffect.compositeEffects[i]);
+    for (; (cursor < effectSize) && (effectsPart.compositeEffects.size() < COMPOSITE_EFFECT_PART); ++cursor) {
         if (effectsPart.type == HDF_EFFECT_TYPE_TIME) {
-            delayTime += hdfCompositeEffect.compositeEffects[i].timeEffect.delay;
+            delayTime += hdfCompositeEffect.compositeEffects[cursor].timeEffect.delay;
         } else if (effectsPart.type == HDF_EFFECT_TYPE_PRIMITIVE) {
-            delayTime += hdfCompositeEffect.compositeEffects[i].primitiveEffect.delay;
+            delayTime += hdfCompositeEffect.compositeEffects[cursor].primitiveEffect.delay;
         } else {
             MISC_HILOGE("Effect type is valid");
-            return ERROR;
-        }
-        if ((effectsPart.compositeEffects.size() >= COMPOSITE_EFFECT_PART) || (i == (effectSize - 1))) {
-            int32_t ret = VibratorDevice.EnableCompositeEffect(identifier, effectsPart);
-            if (ret != SUCCESS) {
-                MISC_HILOGE("EnableCompositeEffect failed");
-                return ERROR;
-            }
-            cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
-            delayTime = 0;
-            effectsPart.compositeEffects.clear();
+            return false;
         }
-        if (exitFlag_) {
-            VibratorDevice.Stop(identifier, HDF_VIBRATOR_MODE_PRESET);
-            MISC_HILOGD("Stop composite effect part, package:%{public}s", info.packageName.c_str());
-            return SUCCESS;
+        effectsPart.compositeEffects.push_back(hdfCompositeEffect.compositeEffects[cursor]);
+    }
+    return true;
+}
+
+int32_t VibratorThread::GetCompositeStartUpTime(const VibratorIdentifierIPC& identifier, int32_t effectType)
+{
+    int32_t mode = (effectType == HDF_EFFECT_TYPE_PRIMITIVE) ? VIBRATE_MODE_MAPPING : VIBRATE_MODE_TIMES;
+    {
+        std::lock_guard<std::mutex> lock(startUpTimesMutex_);
+        auto it = startUpTimes_.find(mode);
+        if (it != startUpTimes_.end()) {
+            return std::max(it->second, 0);
         }
     }
-    return SUCCESS;
+    int32_t startUpTime = 0;
+    int32_t ret = RunHdi(identifier, [&identifier, mode, &startUpTime]() {
+        return VibratorDevice.GetDelayTime(identifier, mode, startUpTime);
+    });
+    if (ret != SUCCESS) {
+        MISC_HILOGW("GetDelayTime fail, composite parts are submitted without lead time");
+        return 0;
+    }
+    return std::max(startUpTime, 0);
 }
 #endif // HDF_DRIVERS_INTERFACE_VIBRATOR
 
-void VibratorThread::UpdateVibratorEffect(const VibrateInfo &info, const VibratorIdentifierIPC& identifier,
-    std::vector<HdfWaveInformation> &waveInfos)
+void VibratorThread::SetStartUpTimes(const std::map<int32_t, int32_t> &startUpTimes)
+{
+    std::lock_guard<std::mutex> lock(startUpTimesMutex_);
+    startUpTimes_ = startUpTimes;
+}
+
+bool VibratorThread::StartWorker()
+{
+    std::lock_guard<std::mutex> workerLck(workerMutex_);
+    if (IsRunning()) {
+        return true;
+    }
+    ThreadStatus status = Start("VibratorThread");
+    if (status != ThreadStatus::OK) {
+        MISC_HILOGE("Start vibrator worker fail, status:%{public}d", static_cast<int32_t>(status));
+        return false;
+    }
+    return true;
+}
+
+uint64_t VibratorThread::PostCommand(VibratorCommand &&command)
 {
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> commandLck(commandMutex_);
+        generation = ++generation_;
+        command.generation = generation;
+        command.postTime = clock_->Now();
+        if (command.type != VibratorCommandType::STOP) {
+            std::lock_guard<std::mutex> lck(currentVibrationMutex_);
+            currentVibration_ = command.info;
+            currentVibrateParams_ = command.identifier;
+            waveInfos_ = command.waveInfos;
+            playing_.store(true);
+        }
+        /** Pending commands have not started yet, the latest one supersedes them */
+        commandQueue_.clear();
+        commandQueue_.push_back(std::move(command));
+        exitFlag_.store(true);
+    }
+    commandCv_.notify_one();
+    std::lock_guard<std::mutex> vibrateLck(vibrateMutex_);
+    cv_.notify_one();
+    return generation;
+}
+
+void VibratorThread::Play(const VibrateInfoPtr &info, const VibratorIdentifierIPC& identifier,
+    const WaveInfosPtr &waveInfos, const std::shared_ptr<PlaybackGroup> &group)
+{
+    if ((info == nullptr) || (waveInfos == nullptr)) {
+        MISC_HILOGE("Invalid playback");
+        return;
+    }
+    if (!StartWorker()) {
+        return;
+    }
+    VibratorCommand command;
+    command.type = IsPlaying() ? VibratorCommandType::PREEMPT : VibratorCommandType::PLAY;
+    command.info = info;
+    command.identifier = identifier;
+    command.waveInfos = waveInfos;
+    command.group = group;
+    PostCommand(std::move(command));
+}
+
+void VibratorThread::Stop()
+{
+    if (!IsPlaying()) {
+        return;
+    }
+    VibratorCommand command;
+    command.type = VibratorCommandType::STOP;
+    uint64_t generation = PostCommand(std::move(command));
+    std::unique_lock<std::mutex> commandLck(commandMutex_);
+    idleCv_.wait(commandLck, [this, generation] { return quit_ || !playing_.load() || (generation_ != generation); });
+}
+
+void VibratorThread::FinishCommand(uint64_t generation)
+{
+    {
+        std::lock_guard<std::mutex> commandLck(commandMutex_);
+        if (generation != generation_) {
+            MISC_HILOGD("Vibration has been preempted, generation:%{public}" PRIu64, generation);
+            return;
+        }
+        playing_.store(false);
+        ResetVibrateInfo();
+    }
+    idleCv_.notify_all();
+}
+
+bool VibratorThread::IsPlaying() const
+{
+    return playing_.load();
+}
+
+bool VibratorThread::SetClock(const std::shared_ptr<VibratorClock> &clock)
+{
+    std::lock_guard<std::mutex> workerLck(workerMutex_);
+    if ((clock == nullptr) || IsRunning()) {
+        MISC_HILOGE("Clock can only be replaced before the worker starts");
+        return false;
+    }
+    clock_ = clock;
+    return true;
+}
+
+VibratorClock::TimePoint VibratorThread::Now()
+{
+    std::lock_guard<std::mutex> workerLck(workerMutex_);
+    return clock_->Now();
+}
+
+void VibratorThread::UpdateVibratorEffect(const VibrateInfoPtr &info, const VibratorIdentifierIPC& identifier,
+    const WaveInfosPtr &waveInfos)
+{
+    if ((info == nullptr) || (waveInfos == nullptr)) {
+        MISC_HILOGE("Invalid playback");
+        return;
+    }
     std::unique_lock<std::mutex> lck(currentVibrationMutex_);
     currentVibration_ = info;
     currentVibrateParams_ = identifier;
     waveInfos_ = waveInfos;
 }
 
-VibrateInfo VibratorThread::GetCurrentVibrateInfo()
+VibrateInfoPtr VibratorThread::GetCurrentVibrateInfo()
 {
     std::unique_lock<std::mutex> lck(currentVibrationMutex_);
     return currentVibration_;
@@ -293,37 +773,16 @@ VibratorIdentifierIPC VibratorThread::GetCurrentVibrateParams()
     return currentVibrateParams_;
 }
 
-std::vector<HdfWaveInformation> VibratorThread::GetCurrentWaveInfo()
+WaveInfosPtr VibratorThread::GetCurrentWaveInfo()
 {
     std::unique_lock<std::mutex> lck(currentVibrationMutex_);
     return waveInfos_;
 }
 
-void VibratorThread::SetExitStatus(bool status)
-{
-    exitFlag_.store(status);
-}
-
-void VibratorThread::NotifyExit()
-{
-    std::lock_guard<std::mutex> lck(vibrateMutex_);
-    exitFlag_.store(true);
-    cv_.notify_one();
-}
-
 void VibratorThread::ResetVibrateInfo()
 {
     std::unique_lock<std::mutex> lck(currentVibrationMutex_);
-    currentVibration_.mode = "";
-    currentVibration_.packageName = "";
-    currentVibration_.pid = -1;
-    currentVibration_.uid = -1;
-    currentVibration_.usage = 0;
-    currentVibration_.systemUsage = false;
-    currentVibration_.duration = 0;
-    currentVibration_.effect = "";
-    currentVibration_.count = 0;
-    currentVibration_.intensity = 0;
+    currentVibration_ = IDLE_VIBRATE_INFO;
 }
 
 #ifdef OHOS_BUILD_ENABLE_QOS
@@ -340,5 +799,86 @@ void VibratorThread::SetQosForThread()
     }
 }
 #endif // OHOS_BUILD_ENABLE_QOS
+
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
+void VibratorThread::SetRealTimeProfile()
+{
+    std::string policyName = OHOS::system::GetParameter(RT_POLICY_PARAM, "");
+    if (policyName == "fifo" || policyName == "rr") {
+        int32_t policy = (policyName == "fifo") ? SCHED_FIFO : SCHED_RR;
+        sched_param param = {};
+        param.sched_priority = OHOS::system::GetIntParameter(RT_PRIORITY_PARAM, DEFAULT_RT_PRIORITY,
+            sched_get_priority_min(policy), sched_get_priority_max(policy));
+        int32_t ret = pthread_setschedparam(pthread_self(), policy, &param);
+        if (ret != 0) {
+            MISC_HILOGE("Set vibrator thread %{public}s policy failed, ret:%{public}d", policyName.c_str(), ret);
+        } else {
+            MISC_HILOGI("Vibrator thread runs %{public}s, priority:%{public}d", policyName.c_str(),
+                param.sched_priority);
+        }
+    } else if (!policyName.empty()) {
+        MISC_HILOGW("Unknown vibrator thread policy:%{public}s", policyName.c_str());
+    }
+    SetThreadAffinity(OHOS::system::GetParameter(RT_CPUS_PARAM, ""));
+    if (OHOS::system::GetBoolParameter(RT_MLOCK_PARAM, false)) {
+        LockThreadStack();
+    }
+}
+
+void VibratorThread::SetThreadAffinity(const std::string &cpus)
+{
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    /** Accepts a kernel style cpu list, e.g. "0-3" or "4,6-7" */
+    size_t begin = 0;
+    while (begin < cpus.size()) {
+        size_t end = cpus.find(',', begin);
+        std::string range = cpus.substr(begin, (end == std::string::npos) ? std::string::npos : end - begin);
+        begin = (end == std::string::npos) ? cpus.size() : end + 1;
+        int32_t first = 0;
+        int32_t last = 0;
+        int32_t matched = sscanf_s(range.c_str(), "%d-%d", &first, &last);
+        if (matched == 1) {
+            last = first;
+        } else if (matched != 2) {
+            MISC_HILOGE("Invalid vibrator thread cpu list:%{public}s", cpus.c_str());
+            return;
+        }
+        for (int32_t cpu = std::max(first, 0); cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        MISC_HILOGE("Set vibrator thread affinity %{public}s failed, errno:%{public}d", cpus.c_str(), errno);
+        return;
+    }
+    MISC_HILOGI("Vibrator thread bound to cpus:%{public}s", cpus.c_str());
+}
+
+void VibratorThread::LockThreadStack()
+{
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        MISC_HILOGE("Get vibrator thread attr failed");
+        return;
+    }
+    void *stackAddr = nullptr;
+    size_t stackSize = 0;
+    int32_t ret = pthread_attr_getstack(&attr, &stackAddr, &stackSize);
+    pthread_attr_destroy(&attr);
+    if (ret != 0) {
+        MISC_HILOGE("Get vibrator thread stack failed, ret:%{public}d", ret);
+        return;
+    }
+    if (mlock(stackAddr, stackSize) != 0) {
+        MISC_HILOGE("Lock vibrator thread stack failed, errno:%{public}d", errno);
+        return;
+    }
+    MISC_HILOGI("Vibrator thread stack locked, size:%{public}zu", stackSize);
+}
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_RT_PROFILE
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "compatible_connection.h"
+#include "miscdevice_service.h"
+#include "sensors_errors.h"
+#include "vibrator_hdi_connection.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationPreemptionBenchmarkTest"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t BENCHMARK_DEVICE_ID = 1;
+constexpr int32_t BENCHMARK_VIBRATOR_ID = 1;
+constexpr int32_t HOLD_DURATION = 10000;
+constexpr int32_t PERCENT_MEDIAN = 50;
+constexpr int32_t PERCENT_TAIL = 99;
+constexpr int32_t PERCENT_BASE = 100;
+constexpr int64_t DISPATCH_TIMEOUT_US = 1000000;
+constexpr int32_t PATTERN_COUNT = 4;
+constexpr int32_t PATTERN_INTERVAL = 100;
+constexpr int32_t EVENT_DURATION = 50;
+constexpr int32_t EVENT_INTENSITY = 80;
+const std::string PRESET_EFFECT = "haptic.notice.warning";
+
+enum BenchmarkMode {
+    BENCHMARK_MODE_TIME = 0,
+    BENCHMARK_MODE_PRESET,
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    BENCHMARK_MODE_CUSTOM_HD,
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    BENCHMARK_MODE_COMPOSITE,
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    BENCHMARK_MODE_BUTT
+};
+
+int64_t NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Mock HDI that stamps every play request, so latency is measured up to the driver boundary */
+class ProbeConnection : public CompatibleConnection {
+public:
+    ProbeConnection() = default;
+    ~ProbeConnection() override = default;
+
+    int32_t StartOnce(const VibratorIdentifierIPC &identifier, uint32_t duration) override
+    {
+        Mark();
+        return CompatibleConnection::StartOnce(identifier, duration);
+    }
+
+    int32_t Start(const VibratorIdentifierIPC &identifier, const std::string &effectType) override
+    {
+        Mark();
+        return CompatibleConnection::Start(identifier, effectType);
+    }
+
+    int32_t StartByIntensity(const VibratorIdentifierIPC &identifier, const std::string &effect,
+        int32_t intensity) override
+    {
+        Mark();
+        return CompatibleConnection::StartByIntensity(identifier, effect, intensity);
+    }
+
+    int32_t PlayPattern(const VibratorIdentifierIPC &identifier, const VibratePattern &pattern) override
+    {
+        Mark();
+        return CompatibleConnection::PlayPattern(identifier, pattern);
+    }
+
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) override
+    {
+        Mark();
+        return CompatibleConnection::PlayHapticPaket(identifier, packet);
+    }
+
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    int32_t EnableCompositeEffect(const VibratorIdentifierIPC &identifier,
+        const HdfCompositeEffect &hdfCompositeEffect) override
+    {
+        Mark();
+        return CompatibleConnection::EnableCompositeEffect(identifier, hdfCompositeEffect);
+    }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
+    uint64_t GetDispatchCount() const
+    {
+        return dispatchCount_.load();
+    }
+
+    /** Returns the time of the first dispatch after @count, or -1 if none arrived in time */
+    int64_t WaitDispatchAfter(uint64_t count) const
+    {
+        int64_t deadline = NowUs() + DISPATCH_TIMEOUT_US;
+        while (dispatchCount_.load() <= count) {
+            if (NowUs() > deadline) {
+                return -1;
+            }
+            std::this_thread::yield();
+        }
+        return firstDispatchUs_.load();
+    }
+
+    void Arm()
+    {
+        firstDispatchUs_.store(0);
+    }
+
+private:
+    void Mark()
+    {
+        int64_t expected = 0;
+        firstDispatchUs_.compare_exchange_strong(expected, NowUs());
+        dispatchCount_.fetch_add(1);
+    }
+
+    std::atomic_uint64_t dispatchCount_ = 0;
+    std::atomic_int64_t firstDispatchUs_ = 0;
+};
+
+ProbeConnection *g_probe = nullptr;
+auto g_service = MiscdeviceDelayedSpSingleton<MiscdeviceService>::GetInstance();
+
+VibratorIdentifierIPC GetIdentifier()
+{
+    VibratorIdentifierIPC identifier;
+    identifier.deviceId = BENCHMARK_DEVICE_ID;
+    identifier.vibratorId = BENCHMARK_VIBRATOR_ID;
+    identifier.isLocalVibrator = true;
+    return identifier;
+}
+
+void SetUpService()
+{
+    if (g_probe != nullptr) {
+        return;
+    }
+    auto probe = std::make_unique<ProbeConnection>();
+    g_probe = probe.get();
+    VibratorHdiConnection::GetInstance().iVibratorHdiConnection_ = std::move(probe);
+
+    HdfVibratorInfo vibrator;
+    vibrator.deviceId = BENCHMARK_DEVICE_ID;
+    vibrator.vibratorId = BENCHMARK_VIBRATOR_ID;
+    vibrator.isLocal = true;
+    {
+        std::unique_lock<std::shared_mutex> lock(g_service->devicesManageMutex_);
+        g_service->devicesManageMap_.clear();
+    }
+    (void)g_service->InsertVibratorInfo(BENCHMARK_DEVICE_ID, "", { vibrator });
+}
+
+VibratePackage BuildPackage()
+{
+    VibratePackage package;
+    for (int32_t i = 0; i < PATTERN_COUNT; ++i) {
+        VibratePattern pattern;
+        pattern.startTime = i * PATTERN_INTERVAL;
+        pattern.patternDuration = EVENT_DURATION;
+        VibrateEvent event;
+        event.tag = EVENT_TAG_CONTINUOUS;
+        event.time = 0;
+        event.duration = EVENT_DURATION;
+        event.intensity = EVENT_INTENSITY;
+        pattern.events.push_back(event);
+        package.patterns.push_back(pattern);
+    }
+    package.packageDuration = PATTERN_COUNT * PATTERN_INTERVAL;
+    return package;
+}
+
+VibrateInfo BuildInfo(int64_t mode, int32_t duration)
+{
+    VibrateInfo info;
+    info.packageName = "VibrationPreemptionBenchmarkTest";
+    info.pid = getpid();
+    info.uid = getuid();
+    info.count = 1;
+    info.intensity = EVENT_INTENSITY;
+    info.duration = duration;
+    switch (mode) {
+        case BENCHMARK_MODE_TIME:
+            info.mode = VIBRATE_TIME;
+            break;
+        case BENCHMARK_MODE_PRESET:
+            info.mode = VIBRATE_PRESET;
+            info.effect = PRESET_EFFECT;
+            break;
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+        case BENCHMARK_MODE_CUSTOM_HD:
+            info.mode = VIBRATE_CUSTOM_HD;
+            info.package = BuildPackage();
+            break;
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+        case BENCHMARK_MODE_COMPOSITE:
+            info.mode = VIBRATE_CUSTOM_COMPOSITE_EFFECT;
+            info.package = BuildPackage();
+            break;
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+        default:
+            break;
+    }
+    return info;
+}
+
+const char *GetModeName(int64_t mode)
+{
+    switch (mode) {
+        case BENCHMARK_MODE_TIME:
+            return "time";
+        case BENCHMARK_MODE_PRESET:
+            return "preset";
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+        case BENCHMARK_MODE_CUSTOM_HD:
+            return "custom.hd";
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+        case BENCHMARK_MODE_COMPOSITE:
+            return "composite";
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+        default:
+            return "unknown";
+    }
+}
+
+/** Starts @info and returns the request-to-HDI latency in microseconds, -1 if nothing reached the HDI */
+int64_t StartAndMeasure(VibrateInfo &info)
+{
+    VibrateInfoPtr playback = std::make_shared<const VibrateInfo>(info);
+    uint64_t count = g_probe->GetDispatchCount();
+    g_probe->Arm();
+    int64_t begin = NowUs();
+    (void)g_service->StartVibrateThreadControl(GetIdentifier(), playback);
+    int64_t dispatched = g_probe->WaitDispatchAfter(count);
+    return (dispatched < 0) ? -1 : (dispatched - begin);
+}
+
+void StopAll()
+{
+    (void)g_service->StopVibratorService(GetIdentifier());
+}
+
+void ReportLatency(benchmark::State &state, std::vector<int64_t> &samples)
+{
+    state.SetLabel(GetModeName(state.range(0)));
+    if (samples.empty()) {
+        state.SkipWithError("No vibration reached the HDI");
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t size = samples.size();
+    state.counters["p50_us"] = static_cast<double>(samples[size * PERCENT_MEDIAN / PERCENT_BASE]);
+    state.counters["p99_us"] = static_cast<double>(samples[std::min(size - 1, size * PERCENT_TAIL / PERCENT_BASE)]);
+    state.counters["max_us"] = static_cast<double>(samples.back());
+}
+
+void RecordSample(benchmark::State &state, std::vector<int64_t> &samples, int64_t latency)
+{
+    if (latency < 0) {
+        state.SkipWithError("Timed out waiting for the HDI");
+        return;
+    }
+    samples.push_back(latency);
+    state.SetIterationTime(static_cast<double>(latency) / std::micro::den);
+}
+} // namespace
+
+class VibrationPreemptionBenchmarkTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State &state) override
+    {
+        SetUpService();
+        StopAll();
+    }
+
+    void TearDown(const ::benchmark::State &state) override
+    {
+        StopAll();
+    }
+};
+
+/** Idle motor to first HDI play call */
+BENCHMARK_DEFINE_F(VibrationPreemptionBenchmarkTest, Start)(benchmark::State &state)
+{
+    VibrateInfo info = BuildInfo(state.range(0), HOLD_DURATION);
+    std::vector<int64_t> samples;
+    for (auto _ : state) {
+        state.PauseTiming();
+        StopAll();
+        state.ResumeTiming();
+        RecordSample(state, samples, StartAndMeasure(info));
+    }
+    ReportLatency(state, samples);
+}
+
+/** Long running vibration to first HDI play call of the request that replaces it */
+BENCHMARK_DEFINE_F(VibrationPreemptionBenchmarkTest, Preempt)(benchmark::State &state)
+{
+    VibrateInfo holder = BuildInfo(BENCHMARK_MODE_TIME, HOLD_DURATION);
+    VibrateInfo info = BuildInfo(state.range(0), HOLD_DURATION);
+    std::vector<int64_t> samples;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (StartAndMeasure(holder) < 0) {
+            state.SkipWithError("Holder vibration did not start");
+            break;
+        }
+        state.ResumeTiming();
+        RecordSample(state, samples, StartAndMeasure(info));
+    }
+    ReportLatency(state, samples);
+}
+
+/** Stop request to the worker reporting idle */
+BENCHMARK_DEFINE_F(VibrationPreemptionBenchmarkTest, Stop)(benchmark::State &state)
+{
+    VibrateInfo info = BuildInfo(state.range(0), HOLD_DURATION);
+    std::vector<VibratorTarget> targets = g_service->ResolveVibratorTargets(GetIdentifier());
+    auto thread = targets.empty() ? nullptr : targets.front().thread;
+    if (thread == nullptr) {
+        state.SkipWithError("No vibrator thread");
+        return;
+    }
+    std::vector<int64_t> samples;
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (StartAndMeasure(info) < 0) {
+            state.SkipWithError("Vibration did not start");
+            break;
+        }
+        state.ResumeTiming();
+        int64_t begin = NowUs();
+        StopAll();
+        int64_t deadline = begin + DISPATCH_TIMEOUT_US;
+        while (thread->IsPlaying() && NowUs() < deadline) {
+            std::this_thread::yield();
+        }
+        RecordSample(state, samples, thread->IsPlaying() ? -1 : (NowUs() - begin));
+    }
+    ReportLatency(state, samples);
+}
+
+BENCHMARK_REGISTER_F(VibrationPreemptionBenchmarkTest, Start)
+    ->DenseRange(BENCHMARK_MODE_TIME, BENCHMARK_MODE_BUTT - 1)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(VibrationPreemptionBenchmarkTest, Preempt)
+    ->DenseRange(BENCHMARK_MODE_TIME, BENCHMARK_MODE_BUTT - 1)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(VibrationPreemptionBenchmarkTest, Stop)
+    ->DenseRange(BENCHMARK_MODE_TIME, BENCHMARK_MODE_BUTT - 1)->UseManualTime()->Unit(benchmark::kMicrosecond);
+} // namespace Sensors
+} // namespace OHOS
+
+BENCHMARK_MAIN();
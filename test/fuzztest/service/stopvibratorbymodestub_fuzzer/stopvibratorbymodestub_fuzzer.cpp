@@ -84,10 +84,11 @@ bool OnRemoteRequestFuzzTest(const uint8_t *data, size_t size)
     VibratorIdentifierIPC identifier;
     size_t startPos = 0;
     startPos += GetObject<int32_t>(data + startPos, size - startPos, identifier.deviceId);
-    GetObject<int32_t>(data + startPos, size - startPos, identifier.vibratorId);
+    startPos += GetObject<int32_t>(data + startPos, size - startPos, identifier.vibratorId);
     datas.WriteParcelable(&identifier);
-    std::string mode = "";
-    datas.WriteString16(Str8ToStr16(mode));
+    int32_t mode = VIBRATE_BUTT;
+    GetObject<int32_t>(data + startPos, size - startPos, mode);
+    datas.WriteInt32(mode);
     datas.RewindRead(0);
     MessageParcel reply;
     MessageOption option;
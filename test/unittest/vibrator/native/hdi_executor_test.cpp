@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "hdi_executor.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HdiExecutorTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t TEST_DEVICE_ID = 1;
+constexpr int32_t TASK_COUNT = 8;
+constexpr int32_t QUEUE_CAPACITY = 32;
+} // namespace
+
+class HdiExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(HdiExecutorTest, PostTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PostTest_001 in");
+    HdiExecutor executor;
+    executor.Add(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID);
+    std::vector<int32_t> order;
+    for (int32_t i = 0; i < TASK_COUNT; ++i) {
+        ASSERT_TRUE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [&order, i]() { order.push_back(i); }));
+    }
+    ASSERT_TRUE(executor.PostAndWait(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, []() {}));
+    ASSERT_EQ(order.size(), static_cast<size_t>(TASK_COUNT));
+    for (int32_t i = 0; i < TASK_COUNT; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+    std::vector<HdiExecutorStats> stats = executor.GetStats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_GE(stats[0].executed, TASK_COUNT);
+    MISC_HILOGI("PostTest_001 out");
+}
+
+HWTEST_F(HdiExecutorTest, PostTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("PostTest_002 in");
+    HdiExecutor executor;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    executor.Add(HDI_DOMAIN_LIGHT, TEST_DEVICE_ID);
+    ASSERT_TRUE(executor.Post(HDI_DOMAIN_LIGHT, TEST_DEVICE_ID, [released]() { released.wait(); }));
+    int32_t accepted = 0;
+    while (executor.Post(HDI_DOMAIN_LIGHT, TEST_DEVICE_ID, []() {})) {
+        ++accepted;
+        ASSERT_LE(accepted, QUEUE_CAPACITY);
+    }
+    EXPECT_EQ(executor.GetStats()[0].rejected, 1);
+    EXPECT_TRUE(executor.Post(HDI_DOMAIN_LIGHT, TEST_DEVICE_ID, []() {}, true));
+    EXPECT_FALSE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, []() {}));
+    executor.Add(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID);
+    EXPECT_TRUE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, []() {}));
+    release.set_value();
+    executor.Shutdown();
+    EXPECT_TRUE(executor.GetStats().empty());
+    MISC_HILOGI("PostTest_002 out");
+}
+
+HWTEST_F(HdiExecutorTest, PostAndWaitTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PostAndWaitTest_001 in");
+    HdiExecutor executor;
+    executor.Add(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    ASSERT_TRUE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [released]() { released.wait(); }));
+    bool executed = false;
+    EXPECT_FALSE(executor.PostAndWait(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [&executed]() { executed = true; }));
+    release.set_value();
+    ASSERT_TRUE(executor.PostAndWait(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, []() {}));
+    EXPECT_FALSE(executed);
+    MISC_HILOGI("PostAndWaitTest_001 out");
+}
+
+HWTEST_F(HdiExecutorTest, RemoveTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("RemoveTest_001 in");
+    HdiExecutor executor;
+    executor.Add(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID);
+    std::atomic<int32_t> executed = 0;
+    ASSERT_TRUE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [&executed]() { ++executed; }));
+    executor.Remove(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID);
+    EXPECT_EQ(executed, 1);
+    EXPECT_FALSE(executor.Post(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [&executed]() { ++executed; }));
+    EXPECT_FALSE(executor.PostAndWait(HDI_DOMAIN_VIBRATOR, TEST_DEVICE_ID, [&executed]() { ++executed; }));
+    EXPECT_EQ(executed, 1);
+    EXPECT_TRUE(executor.GetStats().empty());
+    MISC_HILOGI("RemoveTest_001 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
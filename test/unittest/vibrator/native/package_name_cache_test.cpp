@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "package_name_cache.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PackageNameCacheTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr size_t CACHE_CAPACITY = 2;
+constexpr uint32_t TOKEN_ID_FIRST = 1001;
+constexpr uint32_t TOKEN_ID_SECOND = 1002;
+constexpr uint32_t TOKEN_ID_THIRD = 1003;
+} // namespace
+
+class PackageNameCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(PackageNameCacheTest, FindTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("FindTest_001 in");
+    PackageNameCache cache(CACHE_CAPACITY);
+    std::string packageName;
+    EXPECT_FALSE(cache.Find(TOKEN_ID_FIRST, packageName));
+    cache.Insert(TOKEN_ID_FIRST, "com.example.first");
+    ASSERT_TRUE(cache.Find(TOKEN_ID_FIRST, packageName));
+    EXPECT_EQ(packageName, "com.example.first");
+    MISC_HILOGI("FindTest_001 out");
+}
+
+HWTEST_F(PackageNameCacheTest, EvictTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("EvictTest_001 in");
+    PackageNameCache cache(CACHE_CAPACITY);
+    std::string packageName;
+    cache.Insert(TOKEN_ID_FIRST, "com.example.first");
+    cache.Insert(TOKEN_ID_SECOND, "com.example.second");
+    ASSERT_TRUE(cache.Find(TOKEN_ID_FIRST, packageName));
+    cache.Insert(TOKEN_ID_THIRD, "com.example.third");
+    EXPECT_EQ(cache.Size(), CACHE_CAPACITY);
+    EXPECT_TRUE(cache.Find(TOKEN_ID_FIRST, packageName));
+    EXPECT_FALSE(cache.Find(TOKEN_ID_SECOND, packageName));
+    EXPECT_TRUE(cache.Find(TOKEN_ID_THIRD, packageName));
+    MISC_HILOGI("EvictTest_001 out");
+}
+
+HWTEST_F(PackageNameCacheTest, EraseTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("EraseTest_001 in");
+    PackageNameCache cache(CACHE_CAPACITY);
+    std::string packageName;
+    cache.Insert(TOKEN_ID_FIRST, "com.example.first");
+    cache.Insert(TOKEN_ID_SECOND, "com.example.second");
+    cache.Erase(TOKEN_ID_FIRST);
+    EXPECT_FALSE(cache.Find(TOKEN_ID_FIRST, packageName));
+    EXPECT_TRUE(cache.Find(TOKEN_ID_SECOND, packageName));
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0U);
+    MISC_HILOGI("EraseTest_001 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
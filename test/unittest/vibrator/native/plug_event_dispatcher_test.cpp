@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "plug_event_dispatcher.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PlugEventDispatcherTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr uintptr_t SLOW_CLIENT = 1;
+constexpr uintptr_t FAST_CLIENT = 2;
+constexpr int32_t PLUG_IN = 1;
+constexpr int32_t PLUG_OUT = 0;
+constexpr int32_t REMOTE_DEVICE_ID = 3;
+constexpr int32_t BURST_DEVICE_NUM = 16;
+constexpr int32_t WAIT_TIMES = 100;
+constexpr int32_t WAIT_INTERVAL = 10;
+} // namespace
+
+class PlugEventDispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+
+protected:
+    bool WaitDelivered(PlugEventDispatcher &dispatcher, uint64_t delivered)
+    {
+        for (int32_t i = 0; i < WAIT_TIMES; ++i) {
+            if (dispatcher.GetStats().delivered >= delivered) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL));
+        }
+        return false;
+    }
+};
+
+HWTEST_F(PlugEventDispatcherTest, PublishTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PublishTest_001 in");
+    PlugEventDispatcher dispatcher;
+    std::promise<VibratorPlugEvent> received;
+    dispatcher.Subscribe(FAST_CLIENT, [&received](const VibratorPlugEvent &event) { received.set_value(event); });
+    dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID, 1);
+    auto future = received.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    VibratorPlugEvent event = future.get();
+    EXPECT_EQ(event.status, PLUG_IN);
+    EXPECT_EQ(event.deviceId, REMOTE_DEVICE_ID);
+    EXPECT_EQ(event.vibratorCnt, 1);
+    MISC_HILOGI("PublishTest_001 out");
+}
+
+HWTEST_F(PlugEventDispatcherTest, SlowClientTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("SlowClientTest_001 in");
+    PlugEventDispatcher dispatcher;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic_int32_t slowDelivered = 0;
+    std::atomic_int32_t fastDelivered = 0;
+    dispatcher.Subscribe(SLOW_CLIENT, [released, &slowDelivered](const VibratorPlugEvent &event) {
+        released.wait();
+        ++slowDelivered;
+    });
+    dispatcher.Subscribe(FAST_CLIENT, [&fastDelivered](const VibratorPlugEvent &event) { ++fastDelivered; });
+    dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID, 1);
+    for (int32_t i = 0; (i < WAIT_TIMES) && (fastDelivered == 0); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL));
+    }
+    EXPECT_EQ(fastDelivered, 1);
+    EXPECT_EQ(slowDelivered, 0);
+    release.set_value();
+    EXPECT_TRUE(WaitDelivered(dispatcher, 2));
+    EXPECT_EQ(slowDelivered, 1);
+    MISC_HILOGI("SlowClientTest_001 out");
+}
+
+HWTEST_F(PlugEventDispatcherTest, CoalesceTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("CoalesceTest_001 in");
+    PlugEventDispatcher dispatcher;
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic_bool first = true;
+    dispatcher.Subscribe(SLOW_CLIENT, [&entered, released, &first](const VibratorPlugEvent &event) {
+        if (first.exchange(false)) {
+            entered.set_value();
+            released.wait();
+        }
+    });
+    dispatcher.Publish(PLUG_IN, 0, 1);
+    ASSERT_EQ(entered.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID, 1);
+    dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID, 1);
+    for (int32_t deviceId = 0; deviceId < BURST_DEVICE_NUM; ++deviceId) {
+        dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID + 1 + deviceId, 1);
+    }
+    release.set_value();
+    PlugEventStats stats = dispatcher.GetStats();
+    EXPECT_EQ(stats.coalesced, 1U);
+    EXPECT_GT(stats.dropped, 0U);
+    EXPECT_TRUE(WaitDelivered(dispatcher, stats.published - stats.coalesced - stats.dropped));
+    MISC_HILOGI("CoalesceTest_001 out");
+}
+
+HWTEST_F(PlugEventDispatcherTest, CoalesceTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("CoalesceTest_002 in");
+    PlugEventDispatcher dispatcher;
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic_bool first = true;
+    std::mutex statusMutex;
+    std::vector<int32_t> statuses;
+    dispatcher.Subscribe(SLOW_CLIENT, [&](const VibratorPlugEvent &event) {
+        if (first.exchange(false)) {
+            entered.set_value();
+            released.wait();
+            return;
+        }
+        std::lock_guard<std::mutex> lock(statusMutex);
+        statuses.push_back(event.status);
+    });
+    dispatcher.Publish(PLUG_IN, 0, 1);
+    ASSERT_EQ(entered.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    dispatcher.Publish(PLUG_OUT, REMOTE_DEVICE_ID, 0);
+    dispatcher.Publish(PLUG_IN, REMOTE_DEVICE_ID, 1);
+    release.set_value();
+    ASSERT_TRUE(WaitDelivered(dispatcher, 3));
+    EXPECT_EQ(dispatcher.GetStats().coalesced, 0U);
+    std::lock_guard<std::mutex> lock(statusMutex);
+    EXPECT_EQ(statuses, std::vector<int32_t>({ PLUG_OUT, PLUG_IN }));
+    MISC_HILOGI("CoalesceTest_002 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "parcel.h"
+
+#include "sensors_errors.h"
+#include "vibrator_infos.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrateBatchIPCTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t BATCH_USAGE = 1;
+constexpr int32_t REMOTE_DEVICE_ID = 3;
+constexpr int32_t ITEM_DURATION = 100;
+constexpr int32_t ITEM_COUNT = 2;
+const std::string ITEM_EFFECT = "haptic.clock.timer";
+} // namespace
+
+class VibrateBatchIPCTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+
+protected:
+    VibrateBatchItemIPC BuildItem(int32_t deviceId, int32_t vibratorId, VibrateMode mode)
+    {
+        VibrateBatchItemIPC item;
+        item.identifier.deviceId = deviceId;
+        item.identifier.vibratorId = vibratorId;
+        item.mode = mode;
+        item.duration = ITEM_DURATION;
+        item.effect = ITEM_EFFECT;
+        item.count = ITEM_COUNT;
+        return item;
+    }
+
+    void WriteHeader(Parcel &parcel, int32_t itemNum)
+    {
+        ASSERT_TRUE(parcel.WriteInt32(BATCH_USAGE));
+        ASSERT_TRUE(parcel.WriteBool(false));
+        ASSERT_TRUE(parcel.WriteInt32(itemNum));
+    }
+};
+
+HWTEST_F(VibrateBatchIPCTest, MarshallingTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("MarshallingTest_001 in");
+    VibrateBatchIPC batch;
+    batch.usage = BATCH_USAGE;
+    batch.items.push_back(BuildItem(0, 0, VIBRATE_TIME));
+    batch.items.push_back(BuildItem(REMOTE_DEVICE_ID, 1, VIBRATE_PRESET));
+    Parcel parcel;
+    ASSERT_TRUE(batch.Marshalling(parcel));
+    std::unique_ptr<VibrateBatchIPC> result(VibrateBatchIPC::Unmarshalling(parcel));
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->usage, BATCH_USAGE);
+    ASSERT_EQ(result->items.size(), batch.items.size());
+    EXPECT_EQ(result->items[1].identifier.deviceId, REMOTE_DEVICE_ID);
+    EXPECT_EQ(result->items[1].mode, VIBRATE_PRESET);
+    EXPECT_EQ(result->items[1].effect, ITEM_EFFECT);
+    EXPECT_EQ(result->items[1].count, ITEM_COUNT);
+    MISC_HILOGI("MarshallingTest_001 out");
+}
+
+HWTEST_F(VibrateBatchIPCTest, UnmarshallingTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("UnmarshallingTest_001 in");
+    Parcel parcel;
+    WriteHeader(parcel, MAX_VIBRATE_BATCH_SIZE + 1);
+    for (int32_t i = 0; i <= MAX_VIBRATE_BATCH_SIZE; ++i) {
+        VibrateBatchItemIPC item = BuildItem(0, i, VIBRATE_TIME);
+        ASSERT_TRUE(item.identifier.Marshalling(parcel));
+        ASSERT_TRUE(parcel.WriteInt32(item.mode) && parcel.WriteInt32(item.duration) &&
+            parcel.WriteString(item.effect) && parcel.WriteInt32(item.count));
+    }
+    std::unique_ptr<VibrateBatchIPC> result(VibrateBatchIPC::Unmarshalling(parcel));
+    EXPECT_EQ(result, nullptr);
+    MISC_HILOGI("UnmarshallingTest_001 out");
+}
+
+HWTEST_F(VibrateBatchIPCTest, UnmarshallingTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("UnmarshallingTest_002 in");
+    Parcel parcel;
+    WriteHeader(parcel, -1);
+    std::unique_ptr<VibrateBatchIPC> result(VibrateBatchIPC::Unmarshalling(parcel));
+    EXPECT_EQ(result, nullptr);
+    MISC_HILOGI("UnmarshallingTest_002 out");
+}
+
+HWTEST_F(VibrateBatchIPCTest, UnmarshallingTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("UnmarshallingTest_003 in");
+    VibrateBatchItemIPC item = BuildItem(0, 0, VIBRATE_TIME);
+    Parcel parcel;
+    WriteHeader(parcel, ITEM_COUNT);
+    ASSERT_TRUE(item.identifier.Marshalling(parcel));
+    ASSERT_TRUE(parcel.WriteInt32(item.mode) && parcel.WriteInt32(item.duration) &&
+        parcel.WriteString(item.effect) && parcel.WriteInt32(item.count));
+    std::unique_ptr<VibrateBatchIPC> result(VibrateBatchIPC::Unmarshalling(parcel));
+    EXPECT_EQ(result, nullptr);
+    MISC_HILOGI("UnmarshallingTest_003 out");
+}
+
+HWTEST_F(VibrateBatchIPCTest, UnmarshallingTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("UnmarshallingTest_004 in");
+    VibrateBatchItemIPC item = BuildItem(0, 0, VIBRATE_TIME);
+    Parcel parcel;
+    WriteHeader(parcel, 1);
+    ASSERT_TRUE(item.identifier.Marshalling(parcel));
+    ASSERT_TRUE(parcel.WriteInt32(VIBRATE_MODE_MAX) && parcel.WriteInt32(item.duration) &&
+        parcel.WriteString(item.effect) && parcel.WriteInt32(item.count));
+    std::unique_ptr<VibrateBatchIPC> result(VibrateBatchIPC::Unmarshalling(parcel));
+    EXPECT_EQ(result, nullptr);
+    MISC_HILOGI("UnmarshallingTest_004 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
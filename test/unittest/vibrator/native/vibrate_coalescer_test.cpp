@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "vibrate_coalescer.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrateCoalescerTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t TEST_PID = 1234;
+constexpr int32_t EFFECT_DURATION = 30;
+constexpr int32_t EFFECT_INTENSITY = 100;
+constexpr int32_t INSIDE_WINDOW = 5;
+} // namespace
+
+class VibrateCoalescerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+
+protected:
+    VibrateInfo BuildPreset(const std::string &effect)
+    {
+        VibrateInfo info;
+        info.mode = VIBRATE_PRESET;
+        info.effect = effect;
+        info.pid = TEST_PID;
+        info.count = 1;
+        info.duration = EFFECT_DURATION;
+        info.intensity = EFFECT_INTENSITY;
+        return info;
+    }
+    VibratorIdentifierIPC identifier_;
+};
+
+HWTEST_F(VibrateCoalescerTest, TryMergeTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("TryMergeTest_001 in");
+    VibrateCoalescer coalescer;
+    VibrateInfo info = BuildPreset("haptic.clock.timer");
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_FALSE(coalescer.TryMerge(identifier_, info, now));
+    coalescer.Record(identifier_, info, now);
+    EXPECT_TRUE(coalescer.TryMerge(identifier_, info, now + std::chrono::milliseconds(INSIDE_WINDOW)));
+    EXPECT_FALSE(coalescer.TryMerge(identifier_, info, now + std::chrono::milliseconds(DEFAULT_COALESCE_WINDOW)));
+    VibrateCoalesceStats stats = coalescer.GetStats();
+    EXPECT_EQ(stats.candidates, 3);
+    EXPECT_EQ(stats.merged, 1);
+    MISC_HILOGI("TryMergeTest_001 out");
+}
+
+HWTEST_F(VibrateCoalescerTest, TryMergeTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("TryMergeTest_002 in");
+    VibrateCoalescer coalescer;
+    auto now = std::chrono::steady_clock::now();
+    coalescer.Record(identifier_, BuildPreset("haptic.clock.timer"), now);
+    EXPECT_FALSE(coalescer.TryMerge(identifier_, BuildPreset("haptic.effect.soft"), now));
+    coalescer.Record(identifier_, BuildPreset("haptic.effect.soft"), now);
+    coalescer.Reset(identifier_);
+    EXPECT_FALSE(coalescer.TryMerge(identifier_, BuildPreset("haptic.effect.soft"), now));
+    EXPECT_EQ(coalescer.GetStats().merged, 0);
+    MISC_HILOGI("TryMergeTest_002 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
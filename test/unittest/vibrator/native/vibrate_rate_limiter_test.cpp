@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "vibrate_rate_limiter.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrateRateLimiterTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t TEST_PID = 1234;
+constexpr int32_t TEST_UID = 20010001;
+constexpr uint32_t TEST_RATE = 10;
+constexpr uint32_t TEST_BURST = 3;
+constexpr int32_t REFILL_INTERVAL = 100;
+} // namespace
+
+class VibrateRateLimiterTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(VibrateRateLimiterTest, TryAcquireTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("TryAcquireTest_001 in");
+    VibrateRateLimiter limiter;
+    limiter.SetRateConfig(USAGE_TOUCH, { TEST_RATE, TEST_BURST });
+    auto now = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BURST; ++i) {
+        EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    }
+    EXPECT_FALSE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    EXPECT_TRUE(limiter.TryAcquire(TEST_PID + 1, TEST_UID, USAGE_TOUCH, now));
+    now += std::chrono::milliseconds(REFILL_INTERVAL);
+    EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    EXPECT_FALSE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    std::vector<VibrateRejectedCaller> callers = limiter.GetRejectedCallers();
+    ASSERT_EQ(callers.size(), 1);
+    EXPECT_EQ(callers[0].pid, TEST_PID);
+    EXPECT_EQ(callers[0].rejected, 2);
+    MISC_HILOGI("TryAcquireTest_001 out");
+}
+
+HWTEST_F(VibrateRateLimiterTest, UnlimitedUsageTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("UnlimitedUsageTest_001 in");
+    VibrateRateLimiter limiter;
+    limiter.SetRateConfig(USAGE_ALARM, VibrateRateConfig());
+    auto now = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BURST * TEST_RATE; ++i) {
+        EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_ALARM, now));
+    }
+    EXPECT_EQ(limiter.GetStats()[USAGE_ALARM].rejected, 0);
+    MISC_HILOGI("UnlimitedUsageTest_001 out");
+}
+
+HWTEST_F(VibrateRateLimiterTest, DefaultConfigTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("DefaultConfigTest_001 in");
+    VibrateRateLimiter limiter;
+    auto now = std::chrono::steady_clock::now();
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        for (uint32_t i = 0; i < TEST_BURST * TEST_RATE; ++i) {
+            EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, usage, now));
+        }
+    }
+    EXPECT_EQ(limiter.GetBucketCount(), 0);
+    MISC_HILOGI("DefaultConfigTest_001 out");
+}
+
+HWTEST_F(VibrateRateLimiterTest, BucketBoundTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("BucketBoundTest_001 in");
+    VibrateRateLimiter limiter;
+    limiter.SetRateConfig(USAGE_TOUCH, { TEST_RATE, 1 });
+    auto now = std::chrono::steady_clock::now();
+    for (int32_t pid = 0; pid < static_cast<int32_t>(MAX_RATE_BUCKETS * 2); ++pid) {
+        EXPECT_TRUE(limiter.TryAcquire(pid, TEST_UID, USAGE_TOUCH, now));
+        now += std::chrono::microseconds(1);
+    }
+    EXPECT_EQ(limiter.GetBucketCount(), MAX_RATE_BUCKETS);
+    int32_t newest = static_cast<int32_t>(MAX_RATE_BUCKETS * 2) - 1;
+    EXPECT_FALSE(limiter.TryAcquire(newest, TEST_UID, USAGE_TOUCH, now));
+    MISC_HILOGI("BucketBoundTest_001 out");
+}
+
+HWTEST_F(VibrateRateLimiterTest, EraseTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("EraseTest_001 in");
+    VibrateRateLimiter limiter;
+    limiter.SetRateConfig(USAGE_TOUCH, { TEST_RATE, 1 });
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    EXPECT_FALSE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    limiter.Erase(TEST_PID);
+    EXPECT_TRUE(limiter.TryAcquire(TEST_PID, TEST_UID, USAGE_TOUCH, now));
+    MISC_HILOGI("EraseTest_001 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "vibration_owner_index.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationOwnerIndexTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t FIRST_PID = 1234;
+constexpr int32_t SECOND_PID = 5678;
+constexpr int32_t REMOTE_DEVICE_ID = 3;
+constexpr uint32_t SESSION_ID = 7;
+} // namespace
+
+class VibrationOwnerIndexTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+
+protected:
+    VibratorIdentifierIPC BuildMotor(int32_t deviceId, int32_t vibratorId)
+    {
+        VibratorIdentifierIPC identifier;
+        identifier.deviceId = deviceId;
+        identifier.vibratorId = vibratorId;
+        return identifier;
+    }
+};
+
+HWTEST_F(VibrationOwnerIndexTest, ReleaseTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("ReleaseTest_001 in");
+    VibrationOwnerIndex ownerIndex;
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0));
+    ownerIndex.Bind(FIRST_PID, BuildMotor(REMOTE_DEVICE_ID, 1));
+    ownerIndex.Bind(SECOND_PID, BuildMotor(0, 1));
+    std::vector<OwnedVibration> owned = ownerIndex.Release(FIRST_PID);
+    ASSERT_EQ(owned.size(), 2U);
+    for (const auto &vibration : owned) {
+        const VibratorIdentifierIPC &identifier = vibration.identifier;
+        EXPECT_TRUE(((identifier.deviceId == 0) && (identifier.vibratorId == 0)) ||
+            ((identifier.deviceId == REMOTE_DEVICE_ID) && (identifier.vibratorId == 1)));
+    }
+    EXPECT_TRUE(ownerIndex.Release(FIRST_PID).empty());
+    EXPECT_EQ(ownerIndex.GetOwnerCount(), 1U);
+    MISC_HILOGI("ReleaseTest_001 out");
+}
+
+HWTEST_F(VibrationOwnerIndexTest, BindTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("BindTest_001 in");
+    VibrationOwnerIndex ownerIndex;
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0));
+    ownerIndex.Bind(SECOND_PID, BuildMotor(0, 0));
+    EXPECT_TRUE(ownerIndex.Release(FIRST_PID).empty());
+    EXPECT_EQ(ownerIndex.Release(SECOND_PID).size(), 1U);
+    EXPECT_EQ(ownerIndex.GetOwnerCount(), 0U);
+    MISC_HILOGI("BindTest_001 out");
+}
+
+HWTEST_F(VibrationOwnerIndexTest, UnbindTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("UnbindTest_001 in");
+    VibrationOwnerIndex ownerIndex;
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0));
+    ownerIndex.Unbind(BuildMotor(0, 0));
+    ownerIndex.Unbind(BuildMotor(0, 1));
+    EXPECT_EQ(ownerIndex.GetOwnerCount(), 0U);
+    EXPECT_TRUE(ownerIndex.Release(FIRST_PID).empty());
+    MISC_HILOGI("UnbindTest_001 out");
+}
+
+HWTEST_F(VibrationOwnerIndexTest, SessionOwnerDeathTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("SessionOwnerDeathTest_001 in");
+    VibrationOwnerIndex ownerIndex;
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0), SESSION_ID);
+    ownerIndex.UnbindSession(BuildMotor(0, 0), SESSION_ID + 1);
+    std::vector<OwnedVibration> owned = ownerIndex.Release(FIRST_PID);
+    ASSERT_EQ(owned.size(), 1U);
+    EXPECT_EQ(owned.front().identifier.vibratorId, 0);
+    EXPECT_EQ(owned.front().sessionId, SESSION_ID);
+    EXPECT_EQ(ownerIndex.GetOwnerCount(), 0U);
+    MISC_HILOGI("SessionOwnerDeathTest_001 out");
+}
+
+HWTEST_F(VibrationOwnerIndexTest, UnbindSessionTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("UnbindSessionTest_001 in");
+    VibrationOwnerIndex ownerIndex;
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0), SESSION_ID);
+    ownerIndex.Bind(FIRST_PID, BuildMotor(0, 0));
+    ownerIndex.UnbindSession(BuildMotor(0, 0), SESSION_ID);
+    EXPECT_EQ(ownerIndex.GetOwnerCount(), 1U);
+    ownerIndex.Bind(SECOND_PID, BuildMotor(0, 1), SESSION_ID);
+    ownerIndex.UnbindSession(BuildMotor(0, 1), SESSION_ID);
+    EXPECT_TRUE(ownerIndex.Release(SECOND_PID).empty());
+    EXPECT_EQ(ownerIndex.Release(FIRST_PID).front().sessionId, 0U);
+    MISC_HILOGI("UnbindSessionTest_001 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
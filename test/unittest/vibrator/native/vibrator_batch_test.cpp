@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include "accesstoken_kit.h"
+#include "token_setproc.h"
+
+#include "sensors_errors.h"
+#include "vibrator_agent.h"
+#include "vibrator_infos.h"
+#include "vibrator_service_client.h"
+#include "vibrator_test_common.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorBatchTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+using namespace Security::AccessToken;
+
+namespace {
+constexpr int32_t TIME_WAIT_FOR_OP = 200;
+constexpr int32_t ITEM_DURATION = 100;
+constexpr int32_t INVALID_DURATION = 0;
+constexpr int32_t ITEM_COUNT = 1;
+const std::string UNSUPPORTED_EFFECT = "haptic.effect.not_exist";
+static MockHapToken* g_mock = nullptr;
+uint64_t g_selfShellTokenId;
+
+PermissionStateFull g_infoManagerTestState = {
+    .grantFlags = {1},
+    .grantStatus = {PermissionState::PERMISSION_GRANTED},
+    .isGeneral = true,
+    .permissionName = "ohos.permission.VIBRATE",
+    .resDeviceID = {"local"}
+};
+
+HapPolicyParams g_infoManagerTestPolicyPrams = {
+    .apl = APL_NORMAL,
+    .domain = "test.domain",
+    .permList = {},
+    .permStateList = {g_infoManagerTestState}
+};
+
+HapInfoParams g_infoManagerTestInfoParms = {
+    .bundleName = "vibratorbatch_test",
+    .userID = 1,
+    .instIndex = 0,
+    .appIDDesc = "vibratorBatchTest"
+};
+} // namespace
+
+class VibratorBatchTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() {}
+    void TearDown();
+
+protected:
+    VibrateBatchItemIPC BuildTimeItem(int32_t duration)
+    {
+        VibrateBatchItemIPC item;
+        item.mode = VIBRATE_TIME;
+        item.duration = duration;
+        return item;
+    }
+};
+
+void VibratorBatchTest::SetUpTestCase()
+{
+    g_selfShellTokenId = GetSelfTokenID();
+    VibratorTestCommon::SetTestEvironment(g_selfShellTokenId);
+    std::vector<std::string> reqPerm;
+    reqPerm.emplace_back("ohos.permission.VIBRATE");
+    g_mock = new (std::nothrow) MockHapToken("vibratorbatch_test", reqPerm, true);
+    VibratorTestCommon::AllocAndGrantHapTokenByTest(g_infoManagerTestInfoParms, g_infoManagerTestPolicyPrams);
+}
+
+void VibratorBatchTest::TearDownTestCase()
+{
+    if (g_mock != nullptr) {
+        delete g_mock;
+        g_mock = nullptr;
+    }
+    EXPECT_EQ(0, SetSelfTokenID(g_selfShellTokenId));
+    VibratorTestCommon::ResetTestEvironment();
+}
+
+void VibratorBatchTest::TearDown()
+{
+    Cancel();
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP));
+}
+
+HWTEST_F(VibratorBatchTest, PlayVibratorBatchTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PlayVibratorBatchTest_001 in");
+    VibrateBatchIPC batch;
+    batch.items.push_back(BuildTimeItem(ITEM_DURATION));
+    EXPECT_EQ(VibratorServiceClient::GetInstance().PlayVibratorBatch(batch), ERR_OK);
+    MISC_HILOGI("PlayVibratorBatchTest_001 out");
+}
+
+HWTEST_F(VibratorBatchTest, PlayVibratorBatchTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("PlayVibratorBatchTest_002 in");
+    VibrateBatchIPC batch;
+    batch.items.push_back(BuildTimeItem(ITEM_DURATION));
+    batch.items.push_back(BuildTimeItem(INVALID_DURATION));
+    EXPECT_EQ(VibratorServiceClient::GetInstance().PlayVibratorBatch(batch), PARAMETER_ERROR);
+    MISC_HILOGI("PlayVibratorBatchTest_002 out");
+}
+
+HWTEST_F(VibratorBatchTest, PlayVibratorBatchTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("PlayVibratorBatchTest_003 in");
+    VibrateBatchIPC batch;
+    batch.items.push_back(BuildTimeItem(ITEM_DURATION));
+    VibrateBatchItemIPC item;
+    item.mode = VIBRATE_PRESET;
+    item.effect = UNSUPPORTED_EFFECT;
+    item.count = ITEM_COUNT;
+    batch.items.push_back(item);
+    EXPECT_NE(VibratorServiceClient::GetInstance().PlayVibratorBatch(batch), ERR_OK);
+    MISC_HILOGI("PlayVibratorBatchTest_003 out");
+}
+
+HWTEST_F(VibratorBatchTest, PlayVibratorBatchTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("PlayVibratorBatchTest_004 in");
+    VibrateBatchIPC batch;
+    batch.items.push_back(BuildTimeItem(ITEM_DURATION));
+    batch.items.push_back(BuildTimeItem(ITEM_DURATION));
+    EXPECT_EQ(VibratorServiceClient::GetInstance().PlayVibratorBatch(batch), PARAMETER_ERROR);
+    MISC_HILOGI("PlayVibratorBatchTest_004 out");
+}
+
+HWTEST_F(VibratorBatchTest, PlayVibratorBatchTest_005, TestSize.Level1)
+{
+    MISC_HILOGI("PlayVibratorBatchTest_005 in");
+    VibrateBatchIPC batch;
+    for (int32_t i = 0; i <= MAX_VIBRATE_BATCH_SIZE; ++i) {
+        VibrateBatchItemIPC item = BuildTimeItem(ITEM_DURATION);
+        item.identifier.vibratorId = i;
+        batch.items.push_back(item);
+    }
+    EXPECT_NE(VibratorServiceClient::GetInstance().PlayVibratorBatch(batch), ERR_OK);
+    MISC_HILOGI("PlayVibratorBatchTest_005 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
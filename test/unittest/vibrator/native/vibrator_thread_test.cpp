@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "compatible_connection.h"
+#include "hdi_executor.h"
+#include "sensors_errors.h"
+#include "vibrator_clock.h"
+#include "vibrator_thread.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorThreadTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t WAIT_IDLE_TIMES = 100;
+constexpr int32_t WAIT_IDLE_INTERVAL = 10;
+constexpr int32_t EFFECT_DURATION = 30;
+constexpr int32_t EFFECT_COUNT = 3;
+constexpr int32_t EFFECT_INTERVAL = 10;
+constexpr int32_t LONG_EFFECT_DURATION = 5000;
+constexpr int32_t FAILED_PREPARE_TIMES = 2;
+constexpr int32_t EVENT_DURATION = 50;
+constexpr int32_t EVENT_INTENSITY = 80;
+const std::vector<int32_t> PATTERN_START_TIMES = { 0, 100, 250, 400 };
+
+/** Mock HDI that records the virtual time of every dispatch */
+class TimelineConnection : public CompatibleConnection {
+public:
+    explicit TimelineConnection(std::shared_ptr<VibratorClock> clock) : clock_(clock) {}
+    ~TimelineConnection() override = default;
+
+    int32_t StartByIntensity(const VibratorIdentifierIPC &identifier, const std::string &effect,
+        int32_t intensity) override
+    {
+        Record();
+        return ERR_OK;
+    }
+
+    int32_t PlayPattern(const VibratorIdentifierIPC &identifier, const VibratePattern &pattern) override
+    {
+        Record(pattern.startTime);
+        return ERR_OK;
+    }
+
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+    int32_t PrepareHapticPaket(const VibratePattern &pattern, HapticPaket &packet) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(recordMutex_);
+            if ((pattern.startTime == failedPrepareTime_) && (failedPrepareTimes_ > 0)) {
+                --failedPrepareTimes_;
+                return ERROR;
+            }
+        }
+        return CompatibleConnection::PrepareHapticPaket(pattern, packet);
+    }
+
+    int32_t PlayHapticPaket(const VibratorIdentifierIPC &identifier, const HapticPaket &packet) override
+    {
+        Record(packet.time);
+        return ERR_OK;
+    }
+
+    int32_t Stop(const VibratorIdentifierIPC &identifier, HdfVibratorMode mode) override
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        ++stopCount_;
+        return ERR_OK;
+    }
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
+    size_t GetDispatchCount()
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        return dispatches_.size();
+    }
+
+    size_t GetStopCount()
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        return stopCount_;
+    }
+
+    std::vector<int32_t> GetPlayedStartTimes()
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        return playedStartTimes_;
+    }
+
+    /** The next PrepareHapticPaket calls for the pattern starting at startTime fail */
+    void FailPrepare(int32_t startTime, int32_t times)
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        failedPrepareTime_ = startTime;
+        failedPrepareTimes_ = times;
+    }
+
+    std::vector<int64_t> GetDispatchOffsets(VibratorClock::TimePoint origin)
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        std::vector<int64_t> offsets;
+        for (const auto &timePoint : dispatches_) {
+            offsets.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(timePoint - origin).count());
+        }
+        return offsets;
+    }
+
+private:
+    void Record(int32_t startTime = -1)
+    {
+        std::lock_guard<std::mutex> lock(recordMutex_);
+        dispatches_.push_back(clock_->Now());
+        if (startTime >= 0) {
+            playedStartTimes_.push_back(startTime);
+        }
+    }
+
+    std::shared_ptr<VibratorClock> clock_;
+    std::mutex recordMutex_;
+    std::vector<VibratorClock::TimePoint> dispatches_;
+    size_t stopCount_ = 0;
+    std::vector<int32_t> playedStartTimes_;
+    int32_t failedPrepareTime_ = -1;
+    int32_t failedPrepareTimes_ = 0;
+};
+} // namespace
+
+class VibratorThreadTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+protected:
+    bool WaitIdle();
+    std::shared_ptr<VirtualVibratorClock> clock_;
+    std::shared_ptr<VibratorThread> thread_;
+    TimelineConnection *connection_ = nullptr;
+    std::unique_ptr<IVibratorHdiConnection> originConnection_;
+};
+
+void VibratorThreadTest::SetUpTestCase()
+{
+}
+
+void VibratorThreadTest::TearDownTestCase()
+{
+}
+
+void VibratorThreadTest::SetUp()
+{
+    clock_ = std::make_shared<VirtualVibratorClock>();
+    auto connection = std::make_unique<TimelineConnection>(clock_);
+    connection_ = connection.get();
+    originConnection_ = std::move(VibratorDevice.iVibratorHdiConnection_);
+    VibratorDevice.iVibratorHdiConnection_ = std::move(connection);
+    HdiExecutorPool.Add(HDI_DOMAIN_VIBRATOR, VibratorIdentifierIPC().deviceId);
+    thread_ = std::make_shared<VibratorThread>();
+    ASSERT_TRUE(thread_->SetClock(clock_));
+}
+
+void VibratorThreadTest::TearDown()
+{
+    thread_->Stop();
+    thread_ = nullptr;
+    connection_ = nullptr;
+    VibratorDevice.iVibratorHdiConnection_ = std::move(originConnection_);
+}
+
+bool VibratorThreadTest::WaitIdle()
+{
+    for (int32_t i = 0; i < WAIT_IDLE_TIMES; ++i) {
+        if (!thread_->IsPlaying()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_IDLE_INTERVAL));
+    }
+    return false;
+}
+
+HWTEST_F(VibratorThreadTest, PlayEffectVirtualClockTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PlayEffectVirtualClockTest_001 in");
+    auto info = std::make_shared<VibrateInfo>();
+    info->mode = VIBRATE_PRESET;
+    info->effect = "haptic.effect.soft";
+    info->duration = EFFECT_DURATION;
+    info->count = EFFECT_COUNT;
+    info->intensity = EVENT_INTENSITY;
+    auto origin = clock_->Now();
+    thread_->Play(info, VibratorIdentifierIPC(), std::make_shared<const std::vector<HdfWaveInformation>>());
+    ASSERT_TRUE(WaitIdle());
+    std::vector<int64_t> offsets = connection_->GetDispatchOffsets(origin);
+    ASSERT_EQ(offsets.size(), static_cast<size_t>(EFFECT_COUNT));
+    for (int32_t i = 0; i < EFFECT_COUNT; ++i) {
+        EXPECT_EQ(offsets[i], i * (EFFECT_DURATION + EFFECT_INTERVAL));
+    }
+    MISC_HILOGI("PlayEffectVirtualClockTest_001 out");
+}
+
+HWTEST_F(VibratorThreadTest, PlayCustomByHdHpticVirtualClockTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PlayCustomByHdHpticVirtualClockTest_001 in");
+    auto info = std::make_shared<VibrateInfo>();
+    info->mode = VIBRATE_CUSTOM_HD;
+    for (int32_t startTime : PATTERN_START_TIMES) {
+        VibratePattern pattern;
+        pattern.startTime = startTime;
+        pattern.patternDuration = EVENT_DURATION;
+        VibrateEvent event;
+        event.tag = EVENT_TAG_CONTINUOUS;
+        event.duration = EVENT_DURATION;
+        event.intensity = EVENT_INTENSITY;
+        pattern.events.push_back(event);
+        info->package.patterns.push_back(pattern);
+    }
+    auto origin = clock_->Now();
+    thread_->Play(info, VibratorIdentifierIPC(), std::make_shared<const std::vector<HdfWaveInformation>>());
+    ASSERT_TRUE(WaitIdle());
+    std::vector<int64_t> offsets = connection_->GetDispatchOffsets(origin);
+    ASSERT_EQ(offsets.size(), PATTERN_START_TIMES.size());
+    for (size_t i = 0; i < PATTERN_START_TIMES.size(); ++i) {
+        EXPECT_EQ(offsets[i], PATTERN_START_TIMES[i]);
+    }
+    MISC_HILOGI("PlayCustomByHdHpticVirtualClockTest_001 out");
+}
+
+#ifdef HDF_DRIVERS_INTERFACE_VIBRATOR
+HWTEST_F(VibratorThreadTest, StageHapticPaketsTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("StageHapticPaketsTest_001 in");
+    auto info = std::make_shared<VibrateInfo>();
+    info->mode = VIBRATE_CUSTOM_HD;
+    for (int32_t startTime : PATTERN_START_TIMES) {
+        VibratePattern pattern;
+        pattern.startTime = startTime;
+        pattern.patternDuration = EVENT_DURATION;
+        info->package.patterns.push_back(pattern);
+    }
+    /** Both lookahead attempts for pattern 2 fail, so it is played unstaged in the middle of the package */
+    connection_->FailPrepare(PATTERN_START_TIMES[2], FAILED_PREPARE_TIMES);
+    thread_->Play(info, VibratorIdentifierIPC(), std::make_shared<const std::vector<HdfWaveInformation>>());
+    ASSERT_TRUE(WaitIdle());
+    EXPECT_EQ(connection_->GetPlayedStartTimes(), PATTERN_START_TIMES);
+    MISC_HILOGI("StageHapticPaketsTest_001 out");
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR
+
+HWTEST_F(VibratorThreadTest, HdiLaneOrderTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("HdiLaneOrderTest_001 in");
+    VibratorIdentifierIPC identifier;
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    ASSERT_TRUE(HdiExecutorPool.Post(HDI_DOMAIN_VIBRATOR, identifier.deviceId, [opened]() { opened.wait(); }));
+    auto info = std::make_shared<VibrateInfo>();
+    info->mode = VIBRATE_PRESET;
+    info->effect = "haptic.effect.soft";
+    info->duration = EFFECT_DURATION;
+    info->count = 1;
+    info->intensity = EVENT_INTENSITY;
+    auto origin = clock_->Now();
+    thread_->Play(info, identifier, std::make_shared<const std::vector<HdfWaveInformation>>());
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_IDLE_INTERVAL));
+    EXPECT_TRUE(connection_->GetDispatchOffsets(origin).empty());
+    gate.set_value();
+    ASSERT_TRUE(WaitIdle());
+    EXPECT_EQ(connection_->GetDispatchOffsets(origin).size(), 1u);
+    MISC_HILOGI("HdiLaneOrderTest_001 out");
+}
+
+#if defined(HDF_DRIVERS_INTERFACE_VIBRATOR) && defined(OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM)
+HWTEST_F(VibratorThreadTest, PreemptTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("PreemptTest_001 in");
+    auto thread = std::make_shared<VibratorThread>();
+    VibratorIdentifierIPC identifier;
+    auto info = std::make_shared<VibrateInfo>();
+    info->mode = VIBRATE_PRESET;
+    info->effect = "haptic.effect.soft";
+    info->duration = LONG_EFFECT_DURATION;
+    info->count = 1;
+    info->intensity = EVENT_INTENSITY;
+    auto waveInfos = std::make_shared<const std::vector<HdfWaveInformation>>();
+    thread->Play(info, identifier, waveInfos);
+    for (int32_t i = 0; (i < WAIT_IDLE_TIMES) && (connection_->GetDispatchCount() == 0); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_IDLE_INTERVAL));
+    }
+    thread->Play(info, identifier, waveInfos);
+    for (int32_t i = 0; (i < WAIT_IDLE_TIMES) && (connection_->GetDispatchCount() < 2); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_IDLE_INTERVAL));
+    }
+    ASSERT_EQ(connection_->GetDispatchCount(), 2u);
+    ASSERT_TRUE(HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, identifier.deviceId, []() {}));
+    EXPECT_EQ(connection_->GetStopCount(), 0u);
+    thread->Stop();
+    ASSERT_TRUE(HdiExecutorPool.PostAndWait(HDI_DOMAIN_VIBRATOR, identifier.deviceId, []() {}));
+    EXPECT_EQ(connection_->GetStopCount(), 1u);
+    MISC_HILOGI("PreemptTest_001 out");
+}
+#endif // HDF_DRIVERS_INTERFACE_VIBRATOR && OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+
+HWTEST_F(VibratorThreadTest, SetClockTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("SetClockTest_001 in");
+    EXPECT_FALSE(thread_->SetClock(nullptr));
+    MISC_HILOGI("SetClockTest_001 out");
+}
+}  // namespace Sensors
+}  // namespace OHOS
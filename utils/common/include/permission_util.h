@@ -16,17 +16,56 @@
 #ifndef PERMISSION_UTIL_H
 #define PERMISSION_UTIL_H
 
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+
 #include "accesstoken_kit.h"
 #include "singleton.h"
 
 namespace OHOS {
 namespace Sensors {
 using namespace Security::AccessToken;
+struct PermissionVerdictStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t size = 0;
+};
+
 class PermissionUtil : public Singleton<PermissionUtil> {
 public:
     PermissionUtil() = default;
     virtual ~PermissionUtil() {};
     int32_t CheckVibratePermission(AccessTokenID callerToken, const std::string &permissionName);
+    void EraseVerdict(AccessTokenID tokenId);
+    void ClearVerdicts();
+    PermissionVerdictStats GetVerdictStats();
+
+private:
+    /** Drops the cached verdict of a token whenever the permission is granted or revoked */
+    class PermissionStateObserver : public PermStateChangeCallbackCustomize {
+    public:
+        explicit PermissionStateObserver(const PermStateChangeScope &scope)
+            : PermStateChangeCallbackCustomize(scope) {}
+        ~PermissionStateObserver() override = default;
+        void PermStateChangeCallback(PermStateChangeInfo &result) override;
+    };
+    using VerdictKey = std::pair<std::string, AccessTokenID>;
+    using Verdict = std::pair<VerdictKey, int32_t>;
+    bool SubscribePermissionState(const std::string &permissionName);
+    void InsertVerdict(const VerdictKey &key, int32_t verdict);
+    std::mutex subscribeMutex_;
+    std::set<std::string> subscribedPermissions_;
+    std::mutex verdictMutex_;
+    /** Most recently used first, bounded like the package name cache */
+    std::list<Verdict> verdicts_;
+    std::map<VerdictKey, std::list<Verdict>::iterator> verdictIndex_;
+    /** Bumped by every invalidation, a verification that raced one is not cached */
+    uint64_t verdictGeneration_ = 0;
+    std::atomic_uint64_t verdictHits_ { 0 };
+    std::atomic_uint64_t verdictMisses_ { 0 };
 };
 } // namespace Sensors
 } // namespace OHOS
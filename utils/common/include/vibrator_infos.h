@@ -16,17 +16,28 @@
 #ifndef VIBRATOR_INFOS_H
 #define VIBRATOR_INFOS_H
 
+#include <memory>
+
 #include "parcel.h"
 namespace OHOS {
 namespace Sensors {
 constexpr int32_t MAX_EVENT_SIZE = 16;
 constexpr int32_t MAX_POINT_SIZE = 16;
-const std::string VIBRATE_BUTT = "butt";
-const std::string VIBRATE_TIME = "time";
-const std::string VIBRATE_PRESET = "preset";
-const std::string VIBRATE_CUSTOM_HD = "custom.hd";
-const std::string VIBRATE_CUSTOM_COMPOSITE_EFFECT = "custom.composite.effect";
-const std::string VIBRATE_CUSTOM_COMPOSITE_TIME = "custom.composite.time";
+constexpr int32_t MAX_VIBRATE_BATCH_SIZE = 16;
+
+/** Playback mode carried end to end, its name is only produced at the API and dump boundaries */
+enum VibrateMode : int32_t {
+    VIBRATE_BUTT = 0,
+    VIBRATE_TIME,
+    VIBRATE_PRESET,
+    VIBRATE_CUSTOM_HD,
+    VIBRATE_CUSTOM_COMPOSITE_EFFECT,
+    VIBRATE_CUSTOM_COMPOSITE_TIME,
+    VIBRATE_MODE_MAX,
+};
+
+const std::string &GetVibrateModeName(int32_t mode);
+bool GetVibrateMode(const std::string &name, VibrateMode &mode);
 
 enum VibrateUsage {
     USAGE_UNKNOWN = 0,
@@ -117,7 +128,7 @@ struct VibrateSlice {
 };
 
 struct VibrateInfo {
-    std::string mode;
+    VibrateMode mode = VIBRATE_BUTT;
     std::string packageName;
     int32_t pid = -1;
     int32_t uid = -1;
@@ -131,6 +142,7 @@ struct VibrateInfo {
     VibratePackage package;
     VibratePackage packageIPC;
 };
+using VibrateInfoPtr = std::shared_ptr<const VibrateInfo>;
 
 struct VibrateParameter : public Parcelable {
     int32_t intensity = 100;  // from 0 to 100
@@ -191,6 +203,24 @@ struct PrimitiveEffectIPC : public Parcelable {
     bool Marshalling(Parcel &parcel) const;
     static PrimitiveEffectIPC* Unmarshalling(Parcel &data);
 };
+
+/** One motor of a batch, mode is VIBRATE_TIME with duration or VIBRATE_PRESET with effect and count */
+struct VibrateBatchItemIPC {
+    VibratorIdentifierIPC identifier;
+    VibrateMode mode = VIBRATE_BUTT;
+    int32_t duration = 0;
+    std::string effect;
+    int32_t count = 0;
+};
+
+struct VibrateBatchIPC : public Parcelable {
+    int32_t usage = 0;
+    bool systemUsage = false;
+    std::vector<VibrateBatchItemIPC> items;
+    void Dump() const;
+    bool Marshalling(Parcel &parcel) const;
+    static VibrateBatchIPC* Unmarshalling(Parcel &data);
+};
 } // namespace Sensors
 } // namespace OHOS
 #endif // VIBRATOR_INFOS_H
@@ -15,12 +15,114 @@
 
 #include "permission_util.h"
 
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PermissionUtil"
+
 namespace OHOS {
 namespace Sensors {
+namespace {
+constexpr size_t VERDICT_CACHE_CAPACITY = 128;
+}  // namespace
 
 int32_t PermissionUtil::CheckVibratePermission(AccessTokenID callerToken, const std::string &permissionName)
 {
-    return AccessTokenKit::VerifyAccessToken(callerToken, permissionName);
+    VerdictKey key(permissionName, callerToken);
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(verdictMutex_);
+        auto it = verdictIndex_.find(key);
+        if (it != verdictIndex_.end()) {
+            verdicts_.splice(verdicts_.begin(), verdicts_, it->second);
+            verdictHits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second->second;
+        }
+        generation = verdictGeneration_;
+    }
+    verdictMisses_.fetch_add(1, std::memory_order_relaxed);
+    int32_t verdict = AccessTokenKit::VerifyAccessToken(callerToken, permissionName);
+    /** Verdicts are only cached while a state change subscription can invalidate them */
+    if (SubscribePermissionState(permissionName)) {
+        std::lock_guard<std::mutex> lock(verdictMutex_);
+        if (generation == verdictGeneration_) {
+            InsertVerdict(key, verdict);
+        }
+    }
+    return verdict;
+}
+
+void PermissionUtil::InsertVerdict(const VerdictKey &key, int32_t verdict)
+{
+    auto it = verdictIndex_.find(key);
+    if (it != verdictIndex_.end()) {
+        it->second->second = verdict;
+        verdicts_.splice(verdicts_.begin(), verdicts_, it->second);
+        return;
+    }
+    if (verdicts_.size() >= VERDICT_CACHE_CAPACITY) {
+        verdictIndex_.erase(verdicts_.back().first);
+        verdicts_.pop_back();
+    }
+    verdicts_.emplace_front(key, verdict);
+    verdictIndex_[key] = verdicts_.begin();
+}
+
+bool PermissionUtil::SubscribePermissionState(const std::string &permissionName)
+{
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    if (subscribedPermissions_.find(permissionName) != subscribedPermissions_.end()) {
+        return true;
+    }
+    PermStateChangeScope scope;
+    scope.permList = { permissionName };
+    auto observer = std::make_shared<PermissionStateObserver>(scope);
+    int32_t ret = AccessTokenKit::RegisterPermStateChangeCallback(observer);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Register permission state change callback fail, ret:%{public}d", ret);
+        return false;
+    }
+    subscribedPermissions_.insert(permissionName);
+    return true;
+}
+
+void PermissionUtil::PermissionStateObserver::PermStateChangeCallback(PermStateChangeInfo &result)
+{
+    MISC_HILOGI("Permission %{public}s changed, type:%{public}d", result.permissionName.c_str(),
+        result.permStateChangeType);
+    PermissionUtil::GetInstance().EraseVerdict(result.tokenID);
+}
+
+void PermissionUtil::EraseVerdict(AccessTokenID tokenId)
+{
+    std::lock_guard<std::mutex> lock(verdictMutex_);
+    ++verdictGeneration_;
+    for (auto it = verdicts_.begin(); it != verdicts_.end();) {
+        if (it->first.second == tokenId) {
+            verdictIndex_.erase(it->first);
+            it = verdicts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PermissionUtil::ClearVerdicts()
+{
+    std::lock_guard<std::mutex> lock(verdictMutex_);
+    ++verdictGeneration_;
+    verdicts_.clear();
+    verdictIndex_.clear();
+}
+
+PermissionVerdictStats PermissionUtil::GetVerdictStats()
+{
+    PermissionVerdictStats stats;
+    stats.hits = verdictHits_.load(std::memory_order_relaxed);
+    stats.misses = verdictMisses_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(verdictMutex_);
+    stats.size = verdicts_.size();
+    return stats;
 }
 } // namespace Sensors
 } // namespace OHOS
\ No newline at end of file
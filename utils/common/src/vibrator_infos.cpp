@@ -23,8 +23,30 @@ namespace OHOS {
 namespace Sensors {
 namespace {
 constexpr int32_t MAX_PATTERN_NUM = 1000;
+const std::string VIBRATE_MODE_NAMES[VIBRATE_MODE_MAX] = {
+    "butt", "time", "preset", "custom.hd", "custom.composite.effect", "custom.composite.time"
+};
 } // namespace
 
+const std::string &GetVibrateModeName(int32_t mode)
+{
+    if ((mode < 0) || (mode >= VIBRATE_MODE_MAX)) {
+        return VIBRATE_MODE_NAMES[VIBRATE_BUTT];
+    }
+    return VIBRATE_MODE_NAMES[mode];
+}
+
+bool GetVibrateMode(const std::string &name, VibrateMode &mode)
+{
+    for (int32_t i = 0; i < VIBRATE_MODE_MAX; ++i) {
+        if (VIBRATE_MODE_NAMES[i] == name) {
+            mode = static_cast<VibrateMode>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 void VibratePattern::Dump() const
 {
     int32_t size = static_cast<int32_t>(events.size());
@@ -754,5 +776,67 @@ void PrimitiveEffectIPC::Dump() const
     MISC_HILOGI("PrimitiveEffectIPC: [%{public}s]", retStr.c_str());
 }
 
+bool VibrateBatchIPC::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteInt32(usage) || !parcel.WriteBool(systemUsage)) {
+        MISC_HILOGE("Write usage or systemUsage failed");
+        return false;
+    }
+    if (!parcel.WriteInt32(static_cast<int32_t>(items.size()))) {
+        MISC_HILOGE("Write items size failed");
+        return false;
+    }
+    for (const auto &item : items) {
+        if (!item.identifier.Marshalling(parcel)) {
+            MISC_HILOGE("Write item identifier failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(item.mode) || !parcel.WriteInt32(item.duration) ||
+            !parcel.WriteString(item.effect) || !parcel.WriteInt32(item.count)) {
+            MISC_HILOGE("Write item failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+VibrateBatchIPC* VibrateBatchIPC::Unmarshalling(Parcel &data)
+{
+    auto batch = new (std::nothrow) VibrateBatchIPC();
+    if (batch == nullptr) {
+        MISC_HILOGE("Read init VibrateBatchIPC failed");
+        return nullptr;
+    }
+    int32_t itemNum = 0;
+    if (!data.ReadInt32(batch->usage) || !data.ReadBool(batch->systemUsage) || !data.ReadInt32(itemNum) ||
+        (itemNum < 0) || (itemNum > MAX_VIBRATE_BATCH_SIZE)) {
+        MISC_HILOGE("Read batch header failed, itemNum:%{public}d", itemNum);
+        delete batch;
+        return nullptr;
+    }
+    for (int32_t i = 0; i < itemNum; ++i) {
+        VibrateBatchItemIPC item;
+        int32_t mode = VIBRATE_BUTT;
+        std::unique_ptr<VibratorIdentifierIPC> identifier(VibratorIdentifierIPC::Unmarshalling(data));
+        if ((identifier == nullptr) || !data.ReadInt32(mode) || !data.ReadInt32(item.duration) ||
+            !data.ReadString(item.effect) || !data.ReadInt32(item.count) || (mode < 0) ||
+            (mode >= VIBRATE_MODE_MAX)) {
+            MISC_HILOGE("Read batch item failed, mode:%{public}d", mode);
+            delete batch;
+            return nullptr;
+        }
+        item.identifier = *identifier;
+        item.mode = static_cast<VibrateMode>(mode);
+        batch->items.push_back(std::move(item));
+    }
+    return batch;
+}
+
+void VibrateBatchIPC::Dump() const
+{
+    MISC_HILOGI("VibrateBatchIPC: [usage: %{public}d systemUsage: %{public}d items: %{public}zu]", usage,
+        systemUsage, items.size());
+}
+
 } // namespace Sensors
 } // namespace OHOS